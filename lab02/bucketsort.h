@@ -0,0 +1,84 @@
+#ifndef BUCKETSORT_H
+#define BUCKETSORT_H
+
+#include "sorteermethode.h"
+#include "insertionsort.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+/** class BucketSort
+    \brief verdeelt de elementen volgens hun waarde over n emmers en sorteert elke emmer apart
+    Voor numerieke T die ongeveer uniform verdeeld zijn over [min, max]: dan bevat elke emmer
+    gemiddeld 1 element en is insertion sort per emmer goedkoop. De emmers liggen na elkaar in
+    een enkele hulptabel (tellen, prefixsom, verdelen), dus er is geen allocatie per emmer.
+*/
+template <typename T>
+class BucketSort : public Sorteermethode<T, BucketSort<T>>{
+    static_assert(std::is_arithmetic_v<T>, "BucketSort werkt enkel op numerieke sleutels");
+
+    public:
+        static constexpr const char* naam = "Bucket sort";
+
+        template <typename RandomIt>
+        void sorteer(RandomIt begin, RandomIt end) const;
+};
+
+template <typename T>
+template <typename RandomIt>
+void BucketSort<T>::sorteer(RandomIt begin, RandomIt end) const{
+    using Waarde = typename std::iterator_traits<RandomIt>::value_type;
+
+    const std::size_t n = end - begin;
+    if (n < 2)
+    {
+        return;
+    }
+
+    const auto [min_it, max_it] = std::minmax_element(begin, end);
+    const double minimum = *min_it;
+    const double maximum = *max_it;
+    if (!(minimum < maximum))
+    {
+        return;
+    }
+
+    const std::size_t aantal_emmers = n;
+    const double schaal = aantal_emmers / (maximum - minimum);
+    auto emmer = [&](const Waarde& x) {
+        return std::min(static_cast<std::size_t>((x - minimum) * schaal), aantal_emmers - 1);
+    };
+
+    std::vector<std::size_t> emmer_begin(aantal_emmers + 1, 0);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        emmer_begin[emmer(begin[i]) + 1]++;
+    }
+    for (std::size_t e = 0; e < aantal_emmers; e++)
+    {
+        emmer_begin[e + 1] += emmer_begin[e];
+    }
+
+    std::vector<Waarde> verdeeld(n);
+    std::vector<std::size_t> volgende(emmer_begin.begin(), emmer_begin.end() - 1);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        verdeeld[volgende[emmer(begin[i])]++] = begin[i];
+    }
+
+    const InsertionSort<T> insertion_sort;
+    for (std::size_t e = 0; e < aantal_emmers; e++)
+    {
+        if (emmer_begin[e + 1] - emmer_begin[e] > 1)
+        {
+            insertion_sort(verdeeld.begin() + emmer_begin[e], verdeeld.begin() + emmer_begin[e + 1]);
+        }
+    }
+
+    std::copy(verdeeld.begin(), verdeeld.end(), begin);
+}
+
+#endif
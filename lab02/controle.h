@@ -0,0 +1,123 @@
+#ifndef CONTROLE_H
+#define CONTROLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/*
+ Controles op het resultaat van een sorteermethode, buiten de getimede code.
+ Alles is O(n) en allocatievrij, behalve de stabiliteitstest die een eigen (begrensde) tabel sorteert.
+ Sleutels zijn rekenkundig of tekst die als std::string_view gelezen kan worden (zoals Intstring);
+ tekst wordt rechtstreeks op zijn tekens gehasht, zonder een kopie te maken.
+*/
+
+/** struct Vingerafdruk
+    \brief hash van een multiset: onafhankelijk van de volgorde, dus gelijk voor elke permutatie
+    Elk element wordt gehasht en met twee verschillende mengfuncties opgeteld; een sortering die
+    een element verliest, dupliceert of wijzigt geeft (op 2^-64 na) een andere vingerafdruk.
+*/
+struct Vingerafdruk{
+    std::uint64_t aantal = 0;
+    std::uint64_t som = 0;
+    std::uint64_t som_kwadraten = 0;
+
+    bool operator==(const Vingerafdruk& andere) const
+    {
+        return aantal == andere.aantal && som == andere.som && som_kwadraten == andere.som_kwadraten;
+    }
+    bool operator!=(const Vingerafdruk& andere) const { return !(*this == andere); }
+};
+
+namespace controle
+{
+std::uint64_t meng(std::uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+template <typename T>
+std::uint64_t sleutelhash(const T& x)
+{
+    if constexpr (std::is_arithmetic_v<T>)
+    {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &x, sizeof(x));
+        return bits;
+    }
+    else
+    {
+        static_assert(std::is_convertible_v<const T&, std::string_view>,
+                      "sleutelhash werkt op rekenkundige sleutels en op tekst");
+        return std::hash<std::string_view>{}(std::string_view(x));
+    }
+}
+} // namespace controle
+
+template <typename It>
+Vingerafdruk vingerafdruk(It begin, It end)
+{
+    Vingerafdruk v;
+    for (It it = begin; it != end; ++it)
+    {
+        const std::uint64_t h = controle::meng(controle::sleutelhash(*it));
+        v.aantal++;
+        v.som += h;
+        v.som_kwadraten += controle::meng(h ^ 0x9e3779b97f4a7c15ULL) * h;
+    }
+    return v;
+}
+
+/** struct Gelabeld
+    \brief sleutel met het oorspronkelijke volgnummer; vergelijkingen kijken enkel naar de sleutel
+    Na een stabiele sortering staan gelijke sleutels nog in stijgende volgorde van label.
+*/
+template <typename T>
+struct Gelabeld{
+    T sleutel;
+    std::uint32_t label = 0;
+
+    bool operator<(const Gelabeld& b) const { return sleutel < b.sleutel; }
+    bool operator>(const Gelabeld& b) const { return b.sleutel < sleutel; }
+    bool operator<=(const Gelabeld& b) const { return !(b.sleutel < sleutel); }
+    bool operator>=(const Gelabeld& b) const { return !(sleutel < b.sleutel); }
+    bool operator==(const Gelabeld& b) const { return sleutel == b.sleutel; }
+    bool operator!=(const Gelabeld& b) const { return !(sleutel == b.sleutel); }
+};
+
+/// \fn is_stabiel sorteert lengte gelabelde sleutels met veel dubbels en controleert of gelijke
+/// sleutels hun volgorde behouden hebben. T moet een toekenning van een int toelaten (zoals bij meet).
+template <typename T, typename Sorter>
+bool is_stabiel(const Sorter& sorter, int lengte)
+{
+    std::vector<Gelabeld<T>> tabel(lengte);
+    const int aantal_sleutels = std::max(1, lengte / 8);
+
+    std::uint64_t toestand = 0x2545f4914f6cdd1dULL;
+    for (int i = 0; i < lengte; i++)
+    {
+        toestand = controle::meng(toestand + i);
+        tabel[i].sleutel = static_cast<int>(toestand % aantal_sleutels);
+        tabel[i].label = i;
+    }
+
+    sorter(tabel.begin(), tabel.end());
+
+    for (int i = 1; i < lengte; i++)
+    {
+        if (tabel[i] < tabel[i - 1] || (tabel[i] == tabel[i - 1] && tabel[i].label < tabel[i - 1].label))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef COUNTINGSORT_H
+#define COUNTINGSORT_H
+
+#include "sorteermethode.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+/** class CountingSort
+    \brief telt hoe vaak elke sleutel voorkomt en schrijft de sleutels daarna in volgorde terug
+    Enkel voor gehele T. Het bereik [min, max] wordt eerst bepaald; is het veel groter dan het
+    aantal elementen, dan kost de histogram meer dan hij oplevert en wordt std::sort gebruikt.
+    Er is een enkele histogram van bereik tellers. Bij grote invoer wordt het bereik in delen
+    gesplitst, een per thread: eerst verdeelt elk blok van de invoer zijn elementen over de delen
+    (tellen, prefixsom, verspreiden in een buffer van n elementen), daarna telt en schrijft elke
+    thread enkel de sleutels van zijn eigen deel. Zo is er ook bij een breed bereik (bereik ~ n,
+    zoals bij vul_random) een parallel pad, en blijft het geheugen n elementen plus bereik tellers.
+*/
+template <typename T>
+class CountingSort : public Sorteermethode<T, CountingSort<T>>{
+    static_assert(std::is_integral_v<T>, "CountingSort werkt enkel op gehele sleutels");
+
+    public:
+        static constexpr const char* naam = "Counting sort";
+
+        template <typename RandomIt>
+        void sorteer(RandomIt begin, RandomIt end) const;
+
+    private:
+        // onder deze grootte is een enkele thread sneller dan threads opstarten
+        static constexpr std::size_t parallel_vanaf = 1 << 16;
+        // histogram mag hoogstens zoveel keer groter zijn dan de invoer
+        static constexpr std::size_t max_bereik_factor = 4;
+};
+
+template <typename T>
+template <typename RandomIt>
+void CountingSort<T>::sorteer(RandomIt begin, RandomIt end) const{
+    const std::size_t n = end - begin;
+    if (n < 2)
+    {
+        return;
+    }
+
+    const auto [min_it, max_it] = std::minmax_element(begin, end);
+    const T minimum = *min_it;
+    const std::uint64_t bereik = static_cast<std::uint64_t>(*max_it) - static_cast<std::uint64_t>(minimum) + 1;
+
+    if (bereik == 0 || bereik > max_bereik_factor * n + 256)
+    {
+        std::sort(begin, end);
+        return;
+    }
+
+    const std::size_t threads = (n < parallel_vanaf) ? 1 : aantal_threads(n / parallel_vanaf);
+    std::vector<std::size_t> tellingen(bereik);
+
+    if (threads == 1)
+    {
+        for (RandomIt it = begin; it != end; ++it)
+        {
+            tellingen[static_cast<std::uint64_t>(*it) - static_cast<std::uint64_t>(minimum)]++;
+        }
+        RandomIt uit = begin;
+        for (std::uint64_t sleutel = 0; sleutel < bereik; sleutel++)
+        {
+            uit = std::fill_n(uit, tellingen[sleutel], static_cast<T>(minimum + static_cast<T>(sleutel)));
+        }
+        return;
+    }
+
+    // deel d heeft de sleutels [d << verschuiving, (d + 1) << verschuiving), een macht van twee
+    // zodat het deel van een sleutel een shift is in plaats van een deling
+    int verschuiving = 0;
+    while (((bereik - 1) >> verschuiving) >= threads)
+    {
+        verschuiving++;
+    }
+    const std::size_t aantal_delen = ((bereik - 1) >> verschuiving) + 1;
+    const std::size_t aantal_blokken = threads;
+    const std::size_t blokgrootte = (n + aantal_blokken - 1) / aantal_blokken;
+
+    auto sleutel_van = [&](std::size_t i) {
+        return static_cast<std::uint64_t>(begin[i]) - static_cast<std::uint64_t>(minimum);
+    };
+
+    // positie[b * aantal_delen + d]: aantal elementen van blok b in deel d, na de prefixsom de plaats
+    // in de buffer waar blok b zijn elementen van deel d neerzet
+    std::vector<std::size_t> positie(aantal_blokken * aantal_delen, 0);
+    parallel_voor(aantal_blokken, [&](std::size_t blok) {
+        std::size_t* aantal = positie.data() + blok * aantal_delen;
+        const std::size_t tot = std::min((blok + 1) * blokgrootte, n);
+        for (std::size_t i = blok * blokgrootte; i < tot; i++)
+        {
+            aantal[sleutel_van(i) >> verschuiving]++;
+        }
+    });
+
+    std::vector<std::size_t> deel_begin(aantal_delen + 1, 0);
+    std::size_t som = 0;
+    for (std::size_t deel = 0; deel < aantal_delen; deel++)
+    {
+        deel_begin[deel] = som;
+        for (std::size_t blok = 0; blok < aantal_blokken; blok++)
+        {
+            const std::size_t aantal = positie[blok * aantal_delen + deel];
+            positie[blok * aantal_delen + deel] = som;
+            som += aantal;
+        }
+    }
+    deel_begin[aantal_delen] = som;
+
+    std::vector<T> buffer(n);
+    parallel_voor(aantal_blokken, [&](std::size_t blok) {
+        std::size_t* plaats = positie.data() + blok * aantal_delen;
+        const std::size_t tot = std::min((blok + 1) * blokgrootte, n);
+        for (std::size_t i = blok * blokgrootte; i < tot; i++)
+        {
+            buffer[plaats[sleutel_van(i) >> verschuiving]++] = begin[i];
+        }
+    });
+
+    // elk deel telt zijn eigen stuk van de histogram en schrijft het vanaf zijn eigen positie terug
+    parallel_voor(aantal_delen, [&](std::size_t deel) {
+        for (std::size_t i = deel_begin[deel]; i < deel_begin[deel + 1]; i++)
+        {
+            tellingen[static_cast<std::uint64_t>(buffer[i]) - static_cast<std::uint64_t>(minimum)]++;
+        }
+
+        const std::uint64_t van = static_cast<std::uint64_t>(deel) << verschuiving;
+        const std::uint64_t tot = std::min<std::uint64_t>(van + (std::uint64_t{1} << verschuiving), bereik);
+        RandomIt uit = begin + deel_begin[deel];
+        for (std::uint64_t sleutel = van; sleutel < tot; sleutel++)
+        {
+            uit = std::fill_n(uit, tellingen[sleutel], static_cast<T>(minimum + static_cast<T>(sleutel)));
+        }
+    });
+}
+
+#endif
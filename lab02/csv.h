@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <charconv>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
@@ -18,18 +19,22 @@ public:
     // Scheidingsteken: teken in vlottendekommagetallen
     // Voor een Nederlandstalige excel, scheidingsteken ',' opgeven
     CsvData(const std::string& bestandsnaam, char scheidingsteken = '.', char delimiter = '\t');
+    virtual ~CsvData() = default;
 
     template <class T> // T kan int, unsigned int, float, ... zijn
     void voeg_data_toe(const std::vector<T>& toe_te_voegen_data);
 
-    void voeg_data_toe(const std::vector<double>& nieuwe_data);
+    virtual void voeg_data_toe(const std::vector<double>& nieuwe_data);
 
     std::string to_string() const;
 
     std::string geef_bestandsnaam() const;
-    void write_to_file() const;
+    virtual void write_to_file() const;
 
 protected:
+    // Schrijft waarde in wetenschappelijke notatie achteraan in buffer, met het scheidingsteken al ingevuld
+    void formatteer(std::string& buffer, double waarde) const;
+
     std::vector<std::vector<double>> data;
     char scheidingsteken;
     char delimiter;
@@ -89,9 +94,22 @@ void CsvData::voeg_data_toe(const std::vector<double>& nieuwe_data)
     }
 }
 
+void CsvData::formatteer(std::string& buffer, double waarde) const
+{
+    char tekst[32];
+    auto [einde, fout] =
+            std::to_chars(tekst, tekst + sizeof(tekst), waarde, std::chars_format::scientific, precisie);
+    assert(fout == std::errc{});
+
+    for (const char* c = tekst; c != einde; c++)
+    {
+        buffer.push_back((*c == '.') ? scheidingsteken : *c);
+    }
+}
+
 std::string CsvData::to_string() const
 {
-    std::stringstream out;
+    std::string content;
 
     for (int i = 0; i < max_kolom_grootte; i++)
     {
@@ -99,23 +117,20 @@ std::string CsvData::to_string() const
         {
             if (i < data[j].size())
             {
-                out << std::setprecision(precisie) << std::scientific << data[j][i];
+                formatteer(content, data[j][i]);
             }
 
             if (j == (data.size() - 1))
             {
-                out << '\n';
+                content.push_back('\n');
             }
             else
             {
-                out << delimiter;
+                content.push_back(delimiter);
             }
         }
     }
 
-    std::string content = out.str();
-    std::replace(content.begin(), content.end(), '.', scheidingsteken);
-
     return content;
 }
 
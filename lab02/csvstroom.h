@@ -0,0 +1,106 @@
+#ifndef CSVSTROOM_H
+#define CSVSTROOM_H
+
+#include "csv.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** \class CsvStroom
+ \brief CsvData die elke meting meteen achteraan het bestand toevoegt
+ Bij een crash blijven alle reeds toegevoegde rijen bewaard. Getallen worden met
+ std::to_chars in een herbruikte buffer geschreven; er is geen aparte vervangpas nodig.
+ De oproeper kiest of een bestaand bestand eerst leeggemaakt wordt (standaard, zoals de
+ kolommen-layout die het volledig herschrijft) of dat de rijen achteraan toegevoegd worden.
+*/
+class CsvStroom : public CsvData
+{
+public:
+    // rijen: elke voeg_data_toe is een rij en wordt meteen weggeschreven
+    // kolommen: elke voeg_data_toe is een kolom (zoals CsvData); de rijen zijn pas volledig
+    //           als alle kolommen gekend zijn, dus het bestand wordt bij write_to_file
+    //           (of ten laatste in de destructor) volledig herschreven
+    enum class Layout
+    {
+        rijen,
+        kolommen
+    };
+
+    // enkel voor de rijen-layout: wat er met de rijen van een bestaand bestand gebeurt
+    enum class Openen
+    {
+        leegmaken,
+        achteraan
+    };
+
+    CsvStroom(const std::string& bestandsnaam, Layout layout = Layout::rijen, char scheidingsteken = '.',
+              char delimiter = '\t', Openen openen = Openen::leegmaken);
+    ~CsvStroom() override;
+
+    using CsvData::voeg_data_toe;
+    void voeg_data_toe(const std::vector<double>& nieuwe_data) override;
+
+    void write_to_file() const override;
+
+private:
+    Layout layout;
+    std::ofstream out;
+    std::string buffer;
+    mutable bool niet_weggeschreven = false;
+};
+
+CsvStroom::CsvStroom(const std::string& bestandsnaam, Layout layout, char scheidingsteken, char delimiter,
+                     Openen openen)
+: CsvData{bestandsnaam, scheidingsteken, delimiter}, layout{layout}
+{
+    if (layout == Layout::rijen)
+    {
+        out.open(this->bestandsnaam, (openen == Openen::leegmaken) ? std::ios::trunc : std::ios::app);
+        assert(out);
+    }
+}
+
+CsvStroom::~CsvStroom()
+{
+    if (niet_weggeschreven)
+    {
+        write_to_file();
+    }
+}
+
+void CsvStroom::voeg_data_toe(const std::vector<double>& nieuwe_data)
+{
+    if (layout == Layout::kolommen)
+    {
+        CsvData::voeg_data_toe(nieuwe_data);
+        niet_weggeschreven = true;
+        return;
+    }
+
+    buffer.clear();
+    for (int i = 0; i < nieuwe_data.size(); i++)
+    {
+        if (i > 0)
+        {
+            buffer.push_back(delimiter);
+        }
+        formatteer(buffer, nieuwe_data[i]);
+    }
+    buffer.push_back('\n');
+
+    out.write(buffer.data(), buffer.size());
+    out.flush();
+}
+
+void CsvStroom::write_to_file() const
+{
+    // in rijen-layout staat alles al in het bestand
+    if (layout == Layout::kolommen)
+    {
+        CsvData::write_to_file();
+        niet_weggeschreven = false;
+    }
+}
+
+#endif
@@ -4,14 +4,20 @@
 #include "sorteermethode.h"
 
 template <typename T>
-class InsertionSort : public Sorteermethode<T>{
+class InsertionSort : public Sorteermethode<T, InsertionSort<T>>{
     public:
-        void operator()(vector<T> & v) const;   
+        static constexpr const char* naam = "Insertion sort";
+        static constexpr bool stabiel = true;
+
+        template <typename RandomIt>
+        void sorteer(RandomIt v, RandomIt einde) const;
 };
 
 template <typename T>
-void InsertionSort<T>::operator()(vector<T> & v) const{
-    for(int i = 1; i<v.size(); i++) {
+template <typename RandomIt>
+void InsertionSort<T>::sorteer(RandomIt v, RandomIt einde) const{
+    const auto n = einde - v;
+    for(int i = 1; i<n; i++) {
     	int j = i-1;
     	while(j>-1 && v[j]>v[j+1]) {
 			swap(v[j], v[j+1]);
@@ -21,4 +27,3 @@ void InsertionSort<T>::operator()(vector<T> & v) const{
 }
 
 #endif
-
@@ -1,57 +1,76 @@
 #include "csv.h"
+#include "csvstroom.h"
+#include "resultaatbestand.h"
 #include "intstring.h"
+#include "bucketsort.h"
+#include "countingsort.h"
 #include "insertionsort.h"
 #include "mergesort.h"
+#include "procesmeting.h"
+#include "selectie.h"
 #include "shellsort.h"
 #include "stlsort.h"
 
-#include <array>
 #include <cassert>
 #include <iostream>
-#include <memory>
+#include <type_traits>
 #include <utility>
 
-template <class T>
+// sorteermethodes die enkel vergelijken, en dus voor elke T werken
+using VergelijkendeSorteermethoden = Sorteerlijst<STLSort, InsertionSort, ShellSort, MergeSort>;
+// vul_random en vul_range geven sleutels in [0, n): daar zijn ook de sorteermethodes voor begrensde sleutels bruikbaar
+using IntSorteermethoden = VergelijkendeSorteermethoden::met<CountingSort, BucketSort>;
+using DoubleSorteermethoden = VergelijkendeSorteermethoden::met<BucketSort>;
+// selectie van de k kleinste elementen, met volledig sorteren als referentie
+using Selectiemethoden = Selectiemetingen<Introselect, HeapTopK, PartialQuicksort>::met<STLSort>;
+
+template <class T, class Sorteermethoden>
 void measure_sorts(const std::string& csv_filename)
 {
     constexpr int ondergrens = 10;
     constexpr int bovengrens = 100'000;
 
-    CsvData csv_results{csv_filename, '.', ','};
+    // elke meting in een eigen proces op een vaste core; trage sorteermethodes (insertion sort)
+    // worden na 10 s per lengte afgebroken in plaats van de hele run op te houden.
+    // Elk resultaat wordt (buiten de tijdsmeting) gecontroleerd.
+    const Isolatie isolatie{-1, 10.0, true};
+
+    // elke meting wordt meteen als rij (lengte, random, gesorteerd, omgekeerd) aan het bestand toegevoegd
+    CsvStroom csv_results{csv_filename, CsvStroom::Layout::rijen, '.', ','};
+    // binaire kopie van dezelfde metingen, te vergelijken met een vorige run via vergelijk.cpp
+    Resultaatbestand binary_results{csv_filename + ".sortres", meetkolommen()};
 
-    std::array<std::pair<std::string, std::unique_ptr<Sorteermethode<T>>>, 4> sorters = {
-            std::make_pair("STL sort", std::make_unique<STLSort<T>>()),
-            std::make_pair("Insertion sort", std::make_unique<InsertionSort<T>>()),
-            std::make_pair("Shell sort", std::make_unique<ShellSort<T>>()),
-            std::make_pair("Merge sort", std::make_unique<MergeSort<T>>())};
+    Sorteermethoden::template voor_elke<T>([&](const auto& sorter) {
+        using Sorter = std::decay_t<decltype(sorter)>;
 
-    for (const auto& sorter : sorters)
-    {
         std::cout << std::endl;
-        std::cout << sorter.first << ":" << std::endl;
+        std::cout << Sorter::naam << ":" << std::endl;
         std::cout << std::endl;
 
-        sorter.second->meet(ondergrens, bovengrens, std::cout, csv_results);
-    }
+        meet_geisoleerd(sorter, ondergrens, bovengrens, std::cout, csv_results, isolatie, &binary_results, Sorter::naam);
+    });
 
-    std::cout << std::endl << "Writing data to \"" << csv_results.geef_bestandsnaam() << "\" ..." << std::endl;
     csv_results.write_to_file();
-    std::cout << "Data written" << std::endl << std::endl;
+    std::cout << std::endl << "Data written to \"" << csv_results.geef_bestandsnaam() << "\"" << std::endl << std::endl;
 }
 
 int main()
 {
     std::cout << "===== int =====" << std::endl;
 
-    measure_sorts<int>("sort_int");
+    measure_sorts<int, IntSorteermethoden>("sort_int");
 
     std::cout << "===== double =====" << std::endl;
 
-    measure_sorts<double>("sort_double");
+    measure_sorts<double, DoubleSorteermethoden>("sort_double");
 
     std::cout << "===== Intstring =====" << std::endl;
 
-    measure_sorts<Intstring>("sort_intstring");
+    measure_sorts<Intstring, VergelijkendeSorteermethoden>("sort_intstring");
+
+    std::cout << "===== selectie int =====" << std::endl;
+
+    measure_sorts<int, Selectiemethoden>("select_int");
 
     return 0;
 }
@@ -4,10 +4,16 @@
 #include "sorteermethode.h"
 
 template <typename T>
-class MergeSort : public Sorteermethode<T>{
+class MergeSort : public Sorteermethode<T, MergeSort<T>>{
     public:
-        void operator()(vector<T> & v) const;
-        void merge(vector<T> &v, vector<T> &temp, int l, int m, int r) const;
+        static constexpr const char* naam = "Merge sort";
+        static constexpr bool stabiel = true;
+
+        template <typename RandomIt>
+        void sorteer(RandomIt v, RandomIt einde) const;
+
+        template <typename RandomIt, typename Buffer>
+        void merge(RandomIt v, Buffer &temp, int l, int m, int r) const;
 };
 
 int min(int x, int y) {
@@ -15,13 +21,21 @@ int min(int x, int y) {
 }
 
 template <typename T>
-void MergeSort<T>::operator()(vector<T> & v) const{
-    vector<T> temp(v.size()/2);
+template <typename RandomIt>
+void MergeSort<T>::sorteer(RandomIt v, RandomIt einde) const{
+    const int n = einde - v;
 
-    for (int curr_size = 1; curr_size < v.size()-1; curr_size *= 2) {
-        for(int l = 0; l < v.size()-1; l += curr_size) {
-            int m = min(l + curr_size-1, v.size()-1);
-            int r = min(l + 2*curr_size-1, v.size()-1);
+    // de linkse deelrij van een merge is hoogstens de grootste macht van 2 kleiner dan n
+    int langste_run = 1;
+    while (2*langste_run < n) {
+        langste_run *= 2;
+    }
+    vector<typename std::iterator_traits<RandomIt>::value_type> temp(langste_run);
+
+    for (int curr_size = 1; curr_size < n; curr_size *= 2) {
+        for(int l = 0; l < n-curr_size; l += 2*curr_size) {
+            int m = l + curr_size-1;
+            int r = min(l + 2*curr_size-1, n-1);
 
             merge(v, temp, l, m, r);
         }
@@ -29,7 +43,8 @@ void MergeSort<T>::operator()(vector<T> & v) const{
 }
 
 template <typename T>
-void MergeSort<T>::merge(vector<T> &v, vector<T> &temp, int l, int m, int r) const {
+template <typename RandomIt, typename Buffer>
+void MergeSort<T>::merge(RandomIt v, Buffer &temp, int l, int m, int r) const {
     int p = l;
 	while(p <= m) {
         swap(temp[p-l], v[p]);
@@ -58,4 +73,3 @@ void MergeSort<T>::merge(vector<T> &v, vector<T> &temp, int l, int m, int r) con
 }
 
 #endif
-
@@ -0,0 +1,63 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+
+/// \fn aantal_cores geeft het aantal cores waarop dit proces mag draaien. In een meetproces dat op
+/// een core vastgezet is (zie procesmeting.h) is dat 1, dan zouden extra threads die core enkel delen.
+std::size_t aantal_cores()
+{
+    cpu_set_t cpus;
+    if (sched_getaffinity(0, sizeof(cpus), &cpus) == 0)
+    {
+        return std::max(1, CPU_COUNT(&cpus));
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// \fn aantal_threads geeft het aantal threads om aantal_taken onafhankelijke taken te verdelen
+std::size_t aantal_threads(std::size_t aantal_taken)
+{
+    return std::min<std::size_t>(aantal_cores(), aantal_taken);
+}
+
+/// \fn parallel_voor roept taak(i) op voor elke i in [0, aantal_taken), verdeeld over alle cores.
+/// Thread t voert de taken t, t + aantal_threads, ... uit; de oproepende thread doet mee.
+template <typename Taak>
+void parallel_voor(std::size_t aantal_taken, Taak taak)
+{
+    const std::size_t threads_nodig = aantal_threads(aantal_taken);
+
+    auto voer_uit = [&](std::size_t eerste, std::size_t stap) {
+        for (std::size_t i = eerste; i < aantal_taken; i += stap)
+        {
+            taak(i);
+        }
+    };
+
+    if (threads_nodig <= 1)
+    {
+        voer_uit(0, 1);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(threads_nodig - 1);
+    for (std::size_t t = 1; t < threads_nodig; t++)
+    {
+        threads.emplace_back(voer_uit, t, threads_nodig);
+    }
+    voer_uit(0, threads_nodig);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef PROCESMETING_H
+#define PROCESMETING_H
+
+#include "sorteermethode.h"
+
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <poll.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/** struct Isolatie
+    \brief instellingen voor meet_geisoleerd
+    cpu: core waarop elke meting vastgezet wordt (-1: de laatste core, weg van core 0 die de meeste
+         interrupts afhandelt)
+    tijdsbudget: maximale tijd in seconden voor een lengte (random + gesorteerd + omgekeerd); wie
+         erover gaat wordt afgebroken en de grotere lengtes van die sorteermethode worden overgeslagen
+    controleer: controleer elk resultaat (zie Sorteermethode::meet_lengte)
+*/
+struct Isolatie{
+    int cpu = -1;
+    double tijdsbudget = 10.0;
+    bool controleer = false;
+};
+
+namespace procesmeting
+{
+enum class Uitkomst
+{
+    gemeten,
+    te_traag,
+    fout_resultaat,
+    mislukt
+};
+
+// exitcode van een kindproces waarvan de controle van het resultaat mislukte
+constexpr int foute_controle = 3;
+
+int kies_cpu(int cpu)
+{
+    if (cpu >= 0)
+    {
+        return cpu;
+    }
+    const int aantal = std::thread::hardware_concurrency();
+    return (aantal > 0) ? aantal - 1 : 0;
+}
+
+/// \fn lees_volledig leest precies grootte bytes van fd, met een timeout over het geheel
+bool lees_volledig(int fd, char* buffer, std::size_t grootte, std::chrono::steady_clock::time_point deadline)
+{
+    std::size_t gelezen = 0;
+    while (gelezen < grootte)
+    {
+        const auto resterend = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+        if (resterend.count() <= 0)
+        {
+            return false;
+        }
+
+        pollfd p{fd, POLLIN, 0};
+        if (poll(&p, 1, resterend.count()) <= 0)
+        {
+            return false;
+        }
+
+        const ssize_t n = read(fd, buffer + gelezen, grootte - gelezen);
+        if (n <= 0)
+        {
+            return false;
+        }
+        gelezen += n;
+    }
+    return true;
+}
+
+/// \fn meet_in_kindproces meet een lengte in een apart proces, vastgezet op cpu
+template <typename Sorter>
+Uitkomst meet_in_kindproces(const Sorter& sorter, int aantal_elementen, const Isolatie& isolatie, int cpu,
+                            std::array<double, 3>& tijden)
+{
+    int pijp[2];
+    if (pipe(pijp) != 0)
+    {
+        return Uitkomst::mislukt;
+    }
+
+    const pid_t kind = fork();
+    if (kind < 0)
+    {
+        close(pijp[0]);
+        close(pijp[1]);
+        return Uitkomst::mislukt;
+    }
+
+    if (kind == 0)
+    {
+        close(pijp[0]);
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        sched_setaffinity(0, sizeof(cpus), &cpus);
+
+        try
+        {
+            const std::array<double, 3> resultaat = sorter.meet_lengte(aantal_elementen, isolatie.controleer);
+            const bool ok = write(pijp[1], resultaat.data(), sizeof(resultaat)) == sizeof(resultaat);
+            _exit(ok ? 0 : 1);
+        }
+        catch (const char* fout)
+        {
+            std::cerr << fout << std::endl;
+            _exit(foute_controle);
+        }
+    }
+
+    close(pijp[1]);
+
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                  std::chrono::duration<double>(isolatie.tijdsbudget));
+    const bool ontvangen = lees_volledig(pijp[0], reinterpret_cast<char*>(tijden.data()), sizeof(tijden), deadline);
+    close(pijp[0]);
+
+    if (!ontvangen)
+    {
+        kill(kind, SIGKILL);
+    }
+
+    int status = 0;
+    waitpid(kind, &status, 0);
+
+    if (ontvangen)
+    {
+        return Uitkomst::gemeten;
+    }
+    if (WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL)
+    {
+        return Uitkomst::te_traag;
+    }
+    if (WIFEXITED(status) && WEXITSTATUS(status) == foute_controle)
+    {
+        return Uitkomst::fout_resultaat;
+    }
+    return Uitkomst::mislukt;
+}
+} // namespace procesmeting
+
+/// \fn meet_geisoleerd zoals Sorteermethode::meet, maar elke lengte wordt in een apart kindproces
+/// gemeten, vastgezet op een enkele core. Zo beinvloeden heapfragmentatie, cache en klokfrequentie
+/// van eerdere metingen de volgende niet. Het resultaat komt via een pijp terug en wordt net zoals
+/// bij meet naar os, csv en resultaten geschreven.
+template <typename Sorter>
+void meet_geisoleerd(const Sorter& sorter, int kortste, int langste, std::ostream& os, CsvData& csv,
+                     const Isolatie& isolatie = {}, Resultaatbestand* resultaten = nullptr,
+                     const std::string& naam = "")
+{
+    constexpr int FIELD_WIDTH = Sorter::FIELD_WIDTH;
+    const int cpu = procesmeting::kies_cpu(isolatie.cpu);
+
+    Sorter::schrijf_hoofding(os);
+
+    // leeg de buffers, anders schrijft elk kindproces ze opnieuw uit
+    os.flush();
+    std::cout.flush();
+
+    for (int aantal_elementen = kortste; aantal_elementen < langste; aantal_elementen *= 10)
+    {
+        os << std::setw(FIELD_WIDTH) << aantal_elementen << std::flush;
+
+        std::array<double, 3> tijden;
+        const auto uitkomst =
+                procesmeting::meet_in_kindproces(sorter, aantal_elementen, isolatie, cpu, tijden);
+
+        if (uitkomst == procesmeting::Uitkomst::gemeten)
+        {
+            Sorter::bewaar(aantal_elementen, tijden, os, csv, resultaten, naam);
+            continue;
+        }
+
+        if (uitkomst == procesmeting::Uitkomst::te_traag)
+        {
+            os << "  langer dan " << isolatie.tijdsbudget << " s, grotere lengtes overgeslagen" << std::endl;
+        }
+        else if (uitkomst == procesmeting::Uitkomst::fout_resultaat)
+        {
+            os << "  foutief resultaat, grotere lengtes overgeslagen" << std::endl;
+        }
+        else
+        {
+            os << "  meting mislukt, grotere lengtes overgeslagen" << std::endl;
+        }
+        break;
+    }
+}
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef RANDOMGENERATOR_H
+#define RANDOMGENERATOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "parallel.h"
+
+/** \class Xoshiro256
+ \brief snelle, seedbare pseudo-random generator (xoshiro256**)
+ Voldoet aan UniformRandomBitGenerator, zodat hij ook met std::shuffle en de
+ distributies uit <random> gebruikt kan worden.
+ credits: https://prng.di.unimi.it/xoshiro256starstar.c
+*/
+class Xoshiro256
+{
+public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256(std::uint64_t seed = 0);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()();
+
+    /// \fn begrensd geeft een uniform getal in [0, n), n > 0 (methode van Lemire)
+    /// De bovenste 64 bits van x * n liggen in [0, n); de trekkingen waarvan de onderste 64 bits onder
+    /// 2^64 mod n vallen worden opnieuw gedaan, anders zouden sommige uitkomsten een keer te veel voorkomen.
+    /// Die modulo wordt enkel berekend als de onderste bits kleiner zijn dan n, dus bijna nooit.
+    std::uint64_t begrensd(std::uint64_t n);
+
+    /// \fn reeel geeft een uniform getal in [0, 1)
+    double reeel();
+
+    /// \fn splitmix64 mengt een 64-bit waarde; wordt gebruikt om seeds en deelstromen af te leiden
+    static std::uint64_t splitmix64(std::uint64_t& x);
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k);
+
+    std::uint64_t s[4];
+};
+
+Xoshiro256::Xoshiro256(std::uint64_t seed)
+{
+    for (auto& woord : s)
+    {
+        woord = splitmix64(seed);
+    }
+}
+
+std::uint64_t Xoshiro256::rotl(std::uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+std::uint64_t Xoshiro256::splitmix64(std::uint64_t& x)
+{
+    std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+Xoshiro256::result_type Xoshiro256::operator()()
+{
+    const std::uint64_t resultaat = rotl(s[1] * 5, 7) * 9;
+    const std::uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return resultaat;
+}
+
+std::uint64_t Xoshiro256::begrensd(std::uint64_t n)
+{
+    assert(n > 0);
+
+    unsigned __int128 product = static_cast<unsigned __int128>((*this)()) * n;
+    std::uint64_t onderste = static_cast<std::uint64_t>(product);
+    if (onderste < n)
+    {
+        // 2^64 mod n, in 64 bits berekend als (2^64 - n) mod n
+        const std::uint64_t drempel = -n % n;
+        while (onderste < drempel)
+        {
+            product = static_cast<unsigned __int128>((*this)()) * n;
+            onderste = static_cast<std::uint64_t>(product);
+        }
+    }
+    return static_cast<std::uint64_t>(product >> 64);
+}
+
+double Xoshiro256::reeel()
+{
+    return ((*this)() >> 11) * 0x1.0p-53;
+}
+
+/** \class Zipfverdeling
+ \brief trekt rangen k in [1, n] met P(k) evenredig met 1/k^s
+ Rejection-inversion (Hörmann & Derflinger): geen tabel, dus geen allocatie, en O(1) per trekking.
+*/
+class Zipfverdeling
+{
+public:
+    Zipfverdeling(std::uint64_t n, double s);
+
+    std::uint64_t operator()(Xoshiro256& rng) const;
+
+private:
+    double h(double x) const;
+    double h_integraal(double x) const;
+    double h_integraal_inverse(double x) const;
+
+    static double helper1(double x);
+    static double helper2(double x);
+
+    std::uint64_t n;
+    double exponent;
+    double h_integraal_x1;
+    double h_integraal_n;
+    double drempel;
+};
+
+Zipfverdeling::Zipfverdeling(std::uint64_t n, double s) : n{n}, exponent{s}
+{
+    h_integraal_x1 = h_integraal(1.5) - 1.0;
+    h_integraal_n = h_integraal(n + 0.5);
+    drempel = 2.0 - h_integraal_inverse(h_integraal(2.5) - h(2.0));
+}
+
+std::uint64_t Zipfverdeling::operator()(Xoshiro256& rng) const
+{
+    while (true)
+    {
+        const double u = h_integraal_n + rng.reeel() * (h_integraal_x1 - h_integraal_n);
+        const double x = h_integraal_inverse(u);
+
+        double k = std::floor(x + 0.5);
+        k = std::clamp(k, 1.0, static_cast<double>(n));
+
+        if ((k - x <= drempel) || (u >= h_integraal(k + 0.5) - h(k)))
+        {
+            return static_cast<std::uint64_t>(k);
+        }
+    }
+}
+
+double Zipfverdeling::h(double x) const
+{
+    return std::exp(-exponent * std::log(x));
+}
+
+double Zipfverdeling::h_integraal(double x) const
+{
+    const double log_x = std::log(x);
+    return helper2((1.0 - exponent) * log_x) * log_x;
+}
+
+double Zipfverdeling::h_integraal_inverse(double x) const
+{
+    double t = x * (1.0 - exponent);
+    if (t < -1.0)
+    {
+        t = -1.0;
+    }
+    return std::exp(helper1(t) * x);
+}
+
+// log(1 + x) / x, numeriek stabiel rond 0
+double Zipfverdeling::helper1(double x)
+{
+    if (std::abs(x) > 1e-8)
+    {
+        return std::log1p(x) / x;
+    }
+    return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+// (exp(x) - 1) / x, numeriek stabiel rond 0
+double Zipfverdeling::helper2(double x)
+{
+    if (std::abs(x) > 1e-8)
+    {
+        return std::expm1(x) / x;
+    }
+    return 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+}
+
+/// \fn vul_parallel verdeelt [begin, end) in blokken van vaste grootte en vult elk blok met
+/// vul(blok_begin, blok_end, rng). Elk blok krijgt een eigen generator afgeleid van seed en
+/// blokindex, dus het resultaat hangt enkel af van seed en niet van het aantal threads.
+template <typename Iterator, typename Vuller>
+void vul_parallel(Iterator begin, Iterator end, std::uint64_t seed, Vuller vul)
+{
+    constexpr std::size_t blokgrootte = 1 << 16;
+
+    const std::size_t aantal = std::distance(begin, end);
+    const std::size_t aantal_blokken = (aantal + blokgrootte - 1) / blokgrootte;
+
+    parallel_voor(aantal_blokken, [&](std::size_t blok) {
+        std::uint64_t blokseed = seed ^ (blok * 0xd1b54a32d192ed03ULL);
+        Xoshiro256 rng{Xoshiro256::splitmix64(blokseed)};
+
+        const std::size_t van = blok * blokgrootte;
+        const std::size_t tot = std::min(van + blokgrootte, aantal);
+        vul(begin + van, begin + tot, rng);
+    });
+}
+
+#endif
@@ -0,0 +1,365 @@
+#ifndef RESULTAATBESTAND_H
+#define RESULTAATBESTAND_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ Binair formaat voor meetresultaten, zodat runs van verschillende commits vergeleken kunnen
+ worden zonder tekst te parsen.
+
+ header:  char magic[8] = "SORTRES1"
+          uint32 aantal_kolommen, uint32 recordgrootte
+          per kolom: char naam[32], uint32 type, uint32 breedte
+ records: recordgrootte bytes per meting, de kolommen na elkaar
+
+ Alle velden zijn een veelvoud van 8 bytes breed, dus elk record (en de header) is 8-byte
+ gealigneerd en het bestand kan rechtstreeks gemapt worden. Nieuwe records worden achteraan
+ toegevoegd; een half geschreven laatste record (bv. na een crash) wordt door de lezer genegeerd
+ en door de schrijver weggeknipt voor hij verder schrijft, anders zouden alle volgende records
+ verschoven zijn.
+*/
+
+enum class Kolomtype : std::uint32_t
+{
+    geheel = 0, // int64
+    reeel = 1,  // double
+    tekst = 2   // vaste breedte, aangevuld met nullen (maximaal tekstbreedte - 1 tekens)
+};
+
+struct Kolom
+{
+    std::string naam;
+    Kolomtype type;
+};
+
+using Waarde = std::variant<std::int64_t, double, std::string>;
+
+namespace resultaatformaat
+{
+constexpr char magic[8] = {'S', 'O', 'R', 'T', 'R', 'E', 'S', '1'};
+constexpr std::uint32_t naamlengte = 32;
+constexpr std::uint32_t tekstbreedte = 32;
+constexpr std::uint32_t headergrootte = sizeof(magic) + 2 * sizeof(std::uint32_t);
+constexpr std::uint32_t kolomheadergrootte = naamlengte + 2 * sizeof(std::uint32_t);
+
+std::uint32_t breedte(Kolomtype type)
+{
+    return (type == Kolomtype::tekst) ? tekstbreedte : 8;
+}
+} // namespace resultaatformaat
+
+/** \class Resultaatbestand
+ \brief voegt records toe aan een binair resultaatbestand
+ Bestaat het bestand al, dan moet het dezelfde kolommen hebben; anders wordt een header geschreven.
+ Een onvolledig laatste record in een bestaand bestand wordt eerst weggeknipt.
+*/
+class Resultaatbestand
+{
+public:
+    Resultaatbestand(const std::string& bestandsnaam, const std::vector<Kolom>& kolommen);
+
+    Resultaatbestand(const Resultaatbestand&) = delete;
+    Resultaatbestand& operator=(const Resultaatbestand&) = delete;
+
+    /// \fn voeg_toe schrijft een record weg; waarden staan in dezelfde volgorde als de kolommen
+    /// Een tekstwaarde van tekstbreedte (32) tekens of meer wordt geweigerd, net zoals een te lange kolomnaam.
+    void voeg_toe(const std::vector<Waarde>& waarden);
+
+    std::string geef_bestandsnaam() const;
+
+private:
+    std::string header() const;
+
+    std::string bestandsnaam;
+    std::vector<Kolom> kolommen;
+    std::uint32_t recordgrootte = 0;
+    std::ofstream out;
+    std::string buffer;
+};
+
+Resultaatbestand::Resultaatbestand(const std::string& bestandsnaam, const std::vector<Kolom>& kolommen)
+: bestandsnaam{bestandsnaam}, kolommen{kolommen}
+{
+    for (const auto& kolom : kolommen)
+    {
+        if (kolom.naam.size() >= resultaatformaat::naamlengte)
+        {
+            throw "Kolomnaam te lang";
+        }
+        recordgrootte += resultaatformaat::breedte(kolom.type);
+    }
+
+    const std::string verwachte_header = header();
+
+    std::ifstream bestaand(bestandsnaam, std::ios::binary);
+    if (bestaand)
+    {
+        std::string bestaande_header(verwachte_header.size(), '\0');
+        bestaand.read(&bestaande_header[0], bestaande_header.size());
+
+        if (bestaand.gcount() > 0 && bestaande_header != verwachte_header)
+        {
+            throw "Resultaatbestand heeft andere kolommen";
+        }
+        if (bestaand.gcount() == static_cast<std::streamsize>(verwachte_header.size()))
+        {
+            bestaand.close();
+            const std::uintmax_t data = std::filesystem::file_size(bestandsnaam) - verwachte_header.size();
+            const std::uintmax_t volledig = (recordgrootte == 0) ? 0 : data - data % recordgrootte;
+            if (volledig != data)
+            {
+                std::filesystem::resize_file(bestandsnaam, verwachte_header.size() + volledig);
+            }
+            out.open(bestandsnaam, std::ios::binary | std::ios::app);
+            assert(out);
+            return;
+        }
+    }
+
+    out.open(bestandsnaam, std::ios::binary | std::ios::trunc);
+    assert(out);
+    out.write(verwachte_header.data(), verwachte_header.size());
+    out.flush();
+}
+
+std::string Resultaatbestand::header() const
+{
+    std::string h(resultaatformaat::headergrootte + kolommen.size() * resultaatformaat::kolomheadergrootte, '\0');
+    char* p = &h[0];
+
+    auto schrijf_uint32 = [&p](std::uint32_t x) {
+        std::memcpy(p, &x, sizeof(x));
+        p += sizeof(x);
+    };
+
+    std::memcpy(p, resultaatformaat::magic, sizeof(resultaatformaat::magic));
+    p += sizeof(resultaatformaat::magic);
+    schrijf_uint32(kolommen.size());
+    schrijf_uint32(recordgrootte);
+
+    for (const auto& kolom : kolommen)
+    {
+        std::memcpy(p, kolom.naam.data(), kolom.naam.size());
+        p += resultaatformaat::naamlengte;
+        schrijf_uint32(static_cast<std::uint32_t>(kolom.type));
+        schrijf_uint32(resultaatformaat::breedte(kolom.type));
+    }
+
+    return h;
+}
+
+void Resultaatbestand::voeg_toe(const std::vector<Waarde>& waarden)
+{
+    assert(waarden.size() == kolommen.size());
+
+    buffer.assign(recordgrootte, '\0');
+    char* p = &buffer[0];
+
+    for (int i = 0; i < kolommen.size(); i++)
+    {
+        switch (kolommen[i].type)
+        {
+        case Kolomtype::geheel:
+        {
+            const std::int64_t x = std::get<std::int64_t>(waarden[i]);
+            std::memcpy(p, &x, sizeof(x));
+            break;
+        }
+        case Kolomtype::reeel:
+        {
+            const double x = std::get<double>(waarden[i]);
+            std::memcpy(p, &x, sizeof(x));
+            break;
+        }
+        case Kolomtype::tekst:
+        {
+            // afkappen zou verschillende namen samenvoegen tot een sleutel (zie vergelijk)
+            const std::string& x = std::get<std::string>(waarden[i]);
+            if (x.size() >= resultaatformaat::tekstbreedte)
+            {
+                throw "Tekstwaarde te lang voor resultaatbestand";
+            }
+            std::memcpy(p, x.data(), x.size());
+            break;
+        }
+        }
+        p += resultaatformaat::breedte(kolommen[i].type);
+    }
+
+    out.write(buffer.data(), buffer.size());
+    out.flush();
+}
+
+std::string Resultaatbestand::geef_bestandsnaam() const
+{
+    return bestandsnaam;
+}
+
+/** \class Resultaatlezer
+ \brief mapt een resultaatbestand in het geheugen en geeft toegang tot de records
+*/
+class Resultaatlezer
+{
+public:
+    explicit Resultaatlezer(const std::string& bestandsnaam);
+    ~Resultaatlezer();
+
+    Resultaatlezer(const Resultaatlezer&) = delete;
+    Resultaatlezer& operator=(const Resultaatlezer&) = delete;
+
+    const std::vector<Kolom>& geef_kolommen() const;
+    std::size_t aantal_records() const;
+
+    std::int64_t geheel(std::size_t record, int kolom) const;
+    double reeel(std::size_t record, int kolom) const;
+    std::string tekst(std::size_t record, int kolom) const;
+
+private:
+    const char* veld(std::size_t record, int kolom) const;
+
+    const char* begin = nullptr;
+    std::size_t grootte = 0;
+    std::vector<Kolom> kolommen;
+    std::vector<std::uint32_t> offsets;
+    std::uint32_t recordgrootte = 0;
+    std::size_t data_offset = 0;
+    std::size_t aantal = 0;
+};
+
+Resultaatlezer::Resultaatlezer(const std::string& bestandsnaam)
+{
+    const int fd = open(bestandsnaam.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw "Kan resultaatbestand niet openen";
+    }
+
+    struct stat info;
+    fstat(fd, &info);
+    grootte = info.st_size;
+
+    if (grootte < resultaatformaat::headergrootte)
+    {
+        close(fd);
+        throw "Ongeldig resultaatbestand";
+    }
+
+    void* map = mmap(nullptr, grootte, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        throw "Kan resultaatbestand niet mappen";
+    }
+    begin = static_cast<const char*>(map);
+
+    std::uint32_t aantal_kolommen;
+    std::memcpy(&aantal_kolommen, begin + sizeof(resultaatformaat::magic), sizeof(aantal_kolommen));
+    std::memcpy(&recordgrootte, begin + sizeof(resultaatformaat::magic) + sizeof(aantal_kolommen),
+                sizeof(recordgrootte));
+
+    data_offset = resultaatformaat::headergrootte
+                  + static_cast<std::size_t>(aantal_kolommen) * resultaatformaat::kolomheadergrootte;
+    if (std::memcmp(begin, resultaatformaat::magic, sizeof(resultaatformaat::magic)) != 0 || grootte < data_offset)
+    {
+        munmap(map, grootte);
+        throw "Ongeldig resultaatbestand";
+    }
+
+    const char* p = begin + resultaatformaat::headergrootte;
+    std::uint32_t offset = 0;
+    for (std::uint32_t i = 0; i < aantal_kolommen; i++)
+    {
+        std::uint32_t type, breedte;
+        std::memcpy(&type, p + resultaatformaat::naamlengte, sizeof(type));
+        std::memcpy(&breedte, p + resultaatformaat::naamlengte + sizeof(type), sizeof(breedte));
+
+        // een onbekend type of een andere breedte zou elk veld op de verkeerde plaats lezen
+        if (type > static_cast<std::uint32_t>(Kolomtype::tekst)
+            || breedte != resultaatformaat::breedte(static_cast<Kolomtype>(type)))
+        {
+            munmap(map, grootte);
+            throw "Ongeldig resultaatbestand";
+        }
+
+        kolommen.push_back(Kolom{std::string(p, strnlen(p, resultaatformaat::naamlengte)), static_cast<Kolomtype>(type)});
+        offsets.push_back(offset);
+
+        offset += breedte;
+        p += resultaatformaat::kolomheadergrootte;
+    }
+    if (offset != recordgrootte)
+    {
+        munmap(map, grootte);
+        throw "Ongeldig resultaatbestand";
+    }
+
+    aantal = (recordgrootte == 0) ? 0 : (grootte - data_offset) / recordgrootte;
+}
+
+Resultaatlezer::~Resultaatlezer()
+{
+    munmap(const_cast<char*>(begin), grootte);
+}
+
+const std::vector<Kolom>& Resultaatlezer::geef_kolommen() const
+{
+    return kolommen;
+}
+
+std::size_t Resultaatlezer::aantal_records() const
+{
+    return aantal;
+}
+
+const char* Resultaatlezer::veld(std::size_t record, int kolom) const
+{
+    assert(record < aantal);
+    return begin + data_offset + record * recordgrootte + offsets[kolom];
+}
+
+std::int64_t Resultaatlezer::geheel(std::size_t record, int kolom) const
+{
+    assert(kolommen[kolom].type == Kolomtype::geheel);
+    std::int64_t x;
+    std::memcpy(&x, veld(record, kolom), sizeof(x));
+    return x;
+}
+
+double Resultaatlezer::reeel(std::size_t record, int kolom) const
+{
+    assert(kolommen[kolom].type == Kolomtype::reeel);
+    double x;
+    std::memcpy(&x, veld(record, kolom), sizeof(x));
+    return x;
+}
+
+std::string Resultaatlezer::tekst(std::size_t record, int kolom) const
+{
+    assert(kolommen[kolom].type == Kolomtype::tekst);
+    const char* p = veld(record, kolom);
+    return std::string(p, strnlen(p, resultaatformaat::tekstbreedte));
+}
+
+/// \fn meetkolommen de kolommen die Sorteermethode::meet wegschrijft
+std::vector<Kolom> meetkolommen()
+{
+    return {{"sorteermethode", Kolomtype::tekst},
+            {"lengte", Kolomtype::geheel},
+            {"random", Kolomtype::reeel},
+            {"gesorteerd", Kolomtype::reeel},
+            {"omgekeerd", Kolomtype::reeel}};
+}
+
+#endif
@@ -0,0 +1,318 @@
+#ifndef SELECTIE_H
+#define SELECTIE_H
+
+#include "sorteermethode.h"
+#include "insertionsort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+/** class Selectiemethode
+    \brief basisklasse (CRTP) van methodes die de k kleinste elementen vooraan zetten
+    Een afgeleide klasse Afgeleide implementeert
+        template <typename RandomIt> void selecteer(RandomIt begin, RandomIt k, RandomIt end) const;
+    Daarna bevat [begin, k) de k - begin kleinste elementen van [begin, end); of ze gesorteerd
+    zijn hangt af van de methode (zie gesorteerd).
+*/
+template <typename T, typename Afgeleide>
+class Selectiemethode{
+    public:
+/// \fn operator() zet de k kleinste elementen van v vooraan
+        void operator()(vector<T> & v, std::size_t k) const;
+
+        template <typename RandomIt, typename = vereist_random_access<RandomIt>>
+        void operator()(RandomIt begin, RandomIt k, RandomIt end) const;
+};
+
+template <typename T, typename Afgeleide>
+void Selectiemethode<T, Afgeleide>::operator()(vector<T> & v, std::size_t k) const
+{
+    (*this)(v.begin(), v.begin() + std::min(k, v.size()), v.end());
+}
+
+template <typename T, typename Afgeleide>
+template <typename RandomIt, typename>
+void Selectiemethode<T, Afgeleide>::operator()(RandomIt begin, RandomIt k, RandomIt end) const
+{
+    if (begin != k)
+    {
+        static_cast<const Afgeleide&>(*this).selecteer(begin, k, end);
+    }
+}
+
+/** class HeapTopK
+    \brief houdt een max-heap van de k kleinste elementen bij tijdens een enkele doorloop
+    O(n log k); [begin, k) is nadien gesorteerd.
+*/
+template <typename T>
+class HeapTopK : public Selectiemethode<T, HeapTopK<T>>{
+    public:
+        static constexpr const char* naam = "Heap top-k";
+        static constexpr bool gesorteerd = true;
+
+        template <typename RandomIt>
+        void selecteer(RandomIt begin, RandomIt k, RandomIt end) const;
+};
+
+template <typename T>
+template <typename RandomIt>
+void HeapTopK<T>::selecteer(RandomIt begin, RandomIt k, RandomIt end) const
+{
+    std::make_heap(begin, k);
+
+    for (RandomIt it = k; it != end; ++it)
+    {
+        if (*it < *begin)
+        {
+            // grootste van de heap wordt vervangen door het kleinere element
+            std::pop_heap(begin, k);
+            swap(*(k - 1), *it);
+            std::push_heap(begin, k);
+        }
+    }
+
+    std::sort_heap(begin, k);
+}
+
+/** class Introselect
+    \brief nth_element met de partitionering van Floyd-Rivest
+    Voor grote bereiken wordt eerst recursief een steekproef geselecteerd, zodat de spil heel dicht
+    bij het k-de element ligt en er gemiddeld n + min(k, n - k) + o(n) vergelijkingen nodig zijn.
+    Duurt het partitioneren te lang (slechte invoer), dan wordt overgeschakeld op HeapTopK, zodat
+    de slechtste geval O(n log n) blijft. Nadien staat het k-de kleinste element op k - 1 en
+    staan er enkel kleinere of gelijke elementen voor; [begin, k) is niet gesorteerd.
+*/
+template <typename T>
+class Introselect : public Selectiemethode<T, Introselect<T>>{
+    public:
+        static constexpr const char* naam = "Floyd-Rivest";
+        static constexpr bool gesorteerd = false;
+
+        template <typename RandomIt>
+        void selecteer(RandomIt begin, RandomIt k, RandomIt end) const;
+
+    private:
+        template <typename RandomIt>
+        void floyd_rivest(RandomIt a, std::ptrdiff_t links, std::ptrdiff_t rechts, std::ptrdiff_t k, int budget) const;
+
+        // onder deze grootte is een steekproef niet de moeite
+        static constexpr std::ptrdiff_t steekproef_vanaf = 600;
+};
+
+template <typename T>
+template <typename RandomIt>
+void Introselect<T>::selecteer(RandomIt begin, RandomIt k, RandomIt end) const
+{
+    const std::ptrdiff_t n = end - begin;
+    const int budget = 2 * static_cast<int>(std::log2(n) + 1);
+
+    floyd_rivest(begin, 0, n - 1, (k - begin) - 1, budget);
+}
+
+template <typename T>
+template <typename RandomIt>
+void Introselect<T>::floyd_rivest(RandomIt a, std::ptrdiff_t links, std::ptrdiff_t rechts, std::ptrdiff_t k,
+                                  int budget) const
+{
+    while (rechts > links)
+    {
+        if (budget-- == 0)
+        {
+            HeapTopK<T>{}(a + links, a + k + 1, a + rechts + 1);
+            return;
+        }
+
+        if (rechts - links > steekproef_vanaf)
+        {
+            const double n = rechts - links + 1;
+            const double i = k - links + 1;
+            const double z = std::log(n);
+            const double s = 0.5 * std::exp(2 * z / 3);
+            const double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * ((i < n / 2) ? -1 : 1);
+
+            const auto nieuw_links = std::max(links, static_cast<std::ptrdiff_t>(k - i * s / n + sd));
+            const auto nieuw_rechts = std::min(rechts, static_cast<std::ptrdiff_t>(k + (n - i) * s / n + sd));
+            floyd_rivest(a, nieuw_links, nieuw_rechts, k, budget);
+        }
+
+        const auto spil = a[k];
+        std::ptrdiff_t i = links;
+        std::ptrdiff_t j = rechts;
+
+        swap(a[links], a[k]);
+        if (a[rechts] > spil)
+        {
+            swap(a[rechts], a[links]);
+        }
+
+        while (i < j)
+        {
+            swap(a[i], a[j]);
+            i++;
+            j--;
+            while (a[i] < spil)
+            {
+                i++;
+            }
+            while (spil < a[j])
+            {
+                j--;
+            }
+        }
+
+        if (a[links] == spil)
+        {
+            swap(a[links], a[j]);
+        }
+        else
+        {
+            j++;
+            swap(a[j], a[rechts]);
+        }
+
+        if (j <= k)
+        {
+            links = j + 1;
+        }
+        if (k <= j)
+        {
+            rechts = j - 1;
+        }
+    }
+}
+
+/** class PartialQuicksort
+    \brief quicksort die deelbereiken die volledig voorbij k liggen niet meer sorteert
+    O(n + k log k) verwacht; [begin, k) is nadien gesorteerd.
+*/
+template <typename T>
+class PartialQuicksort : public Selectiemethode<T, PartialQuicksort<T>>{
+    public:
+        static constexpr const char* naam = "Partial quicksort";
+        static constexpr bool gesorteerd = true;
+
+        template <typename RandomIt>
+        void selecteer(RandomIt begin, RandomIt k, RandomIt end) const;
+
+    private:
+        // kleine deelbereiken worden met insertion sort afgewerkt
+        static constexpr std::ptrdiff_t insertion_sort_tot = 16;
+};
+
+template <typename T>
+template <typename RandomIt>
+void PartialQuicksort<T>::selecteer(RandomIt begin, RandomIt k, RandomIt end) const
+{
+    while (end - begin > insertion_sort_tot)
+    {
+        // spil: mediaan van eerste, middelste en laatste element
+        RandomIt midden = begin + (end - begin) / 2;
+        if (*midden < *begin)
+        {
+            swap(*midden, *begin);
+        }
+        if (*(end - 1) < *midden)
+        {
+            swap(*(end - 1), *midden);
+            if (*midden < *begin)
+            {
+                swap(*midden, *begin);
+            }
+        }
+        const auto spil = *midden;
+
+        // Hoare-partitie: [begin, i) <= spil <= [i, end)
+        RandomIt i = begin;
+        RandomIt j = end - 1;
+        while (true)
+        {
+            while (*i < spil)
+            {
+                ++i;
+            }
+            while (spil < *j)
+            {
+                --j;
+            }
+            if (i >= j)
+            {
+                break;
+            }
+            swap(*i, *j);
+            ++i;
+            --j;
+        }
+        RandomIt grens = j + 1;
+
+        // het rechterdeel enkel verder sorteren als het nog posities voor k bevat
+        if (grens < k)
+        {
+            selecteer(grens, k, end);
+        }
+        end = grens;
+    }
+
+    InsertionSort<T>{}(begin, end);
+}
+
+/// EersteK<aantal> en EerstePercent<procent> bepalen k als functie van n voor de metingen
+/// (EerstePercent: k = procent% van n)
+template <int aantal>
+struct EersteK{
+    static std::size_t k(std::size_t n) { return std::min<std::size_t>(aantal, n); }
+    static std::string naam() { return "k=" + std::to_string(aantal); }
+};
+
+template <int procent>
+struct EerstePercent{
+    static std::size_t k(std::size_t n) { return std::min(n, std::max<std::size_t>(1, n * procent / 100)); }
+    static std::string naam() { return "k=" + std::to_string(procent) + "%"; }
+};
+
+/** class Selectie
+    \brief maakt van een selectiemethode met een vaste keuze van k een Sorteermethode
+    Zo kan Sorteermethode::meet (en measure_sorts) de selectie timen zoals een sortering.
+*/
+template <template <typename> class Methode, typename K>
+struct Selectie{
+    template <typename T>
+    class Sorteerder : public Sorteermethode<T, Sorteerder<T>>{
+        public:
+            // kort genoeg voor de tekstkolom van een Resultaatbestand (31 tekens), bv. "Floyd-Rivest k=10%"
+            static inline const std::string naam = std::string(Methode<T>::naam) + " " + K::naam();
+
+            template <typename RandomIt>
+            void sorteer(RandomIt begin, RandomIt end) const
+            {
+                Methode<T>{}(begin, begin + K::k(end - begin), end);
+            }
+
+            // na een selectie is de tabel niet gesorteerd: controleer enkel dat vooraan de k kleinste staan
+            template <typename It>
+            static bool is_correct(It begin, It end)
+            {
+                if (begin == end)
+                {
+                    return true;
+                }
+
+                const It k = begin + K::k(end - begin);
+                if (Methode<T>::gesorteerd && !std::is_sorted(begin, k))
+                {
+                    return false;
+                }
+                return k == end || !(*std::min_element(k, end) < *std::max_element(begin, k));
+            }
+    };
+};
+
+/// Selectiemetingen<Methoden...> is een Sorteerlijst met elke methode voor k = 1, 10, 1% en 10% van n
+template <template <typename> class... Methoden>
+using Selectiemetingen = Sorteerlijst<Selectie<Methoden, EersteK<1>>::template Sorteerder...,
+                                      Selectie<Methoden, EersteK<10>>::template Sorteerder...,
+                                      Selectie<Methoden, EerstePercent<1>>::template Sorteerder...,
+                                      Selectie<Methoden, EerstePercent<10>>::template Sorteerder...>;
+
+#endif
@@ -5,15 +5,20 @@
 #include <iostream>
 
 template <typename T>
-class ShellSort : public Sorteermethode<T>{
+class ShellSort : public Sorteermethode<T, ShellSort<T>>{
     public:
-        void operator()(vector<T> & v) const;
+        static constexpr const char* naam = "Shell sort";
+
+        template <typename RandomIt>
+        void sorteer(RandomIt v, RandomIt einde) const;
 };
 
 template <typename T>
-void ShellSort<T>::operator()(vector<T> &v) const {
-	for(int k = v.size()/2; k>0; k/=2) {
-        for(int i = k; i<v.size(); i+=k) {
+template <typename RandomIt>
+void ShellSort<T>::sorteer(RandomIt v, RandomIt einde) const {
+    const auto n = einde - v;
+	for(int k = n/2; k>0; k/=2) {
+        for(int i = k; i<n; i+=k) {
             int j = i-k;
             while(j >= 0 && v[j] > v[j+k]) {
                 swap(v[j], v[j+k]);
@@ -24,4 +29,3 @@ void ShellSort<T>::operator()(vector<T> &v) const {
 }
 
 #endif
-
@@ -4,20 +4,40 @@
 #include <iostream>
 #include "chrono.h"
 #include "csv.h"
+#include "resultaatbestand.h"
+#include "controle.h"
 using std::move;
 using std::swap;
 using std::endl;
 using std::cout;
 #include <algorithm>   // voor sort()-methode uit STL
+#include <array>
+
+#include <iterator>
+#include <type_traits>
+
+/// vereist_random_access<It> is enkel geldig als It een random access iterator is;
+/// te gebruiken als standaard template-argument om andere iteratoren uit te sluiten.
+template <typename It>
+using vereist_random_access = std::enable_if_t<
+        std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>>;
 
 /** class Sorteermethode
-    \brief abstracte klasse van methodes die een vector sorteren
+    \brief basisklasse (CRTP) van methodes die een bereik sorteren
+    Een afgeleide klasse Afgeleide implementeert
+        template <typename RandomIt> void sorteer(RandomIt begin, RandomIt end) const;
+    Alle oproepen gebeuren statisch, dus de sorteermethode kan volledig ge-inlined worden en werkt
+    op elke random access container (vector, array, C-tabel, ...), niet alleen op vector<T>.
 */
-template <typename T>
+template <typename T, typename Afgeleide>
 class Sorteermethode{
     public:
 /// \fn operator() sorteert de vector gegeven door het argument
-        virtual void operator()(vector<T> & v) const = 0;
+        void operator()(vector<T> & v) const;
+
+/// \fn operator() sorteert het bereik [begin, end)
+        template <typename RandomIt, typename = vereist_random_access<RandomIt>>
+        void operator()(RandomIt begin, RandomIt end) const;
 
 /// \fn meet(int kortste, int langste, ostream& os) schrijft naar os een overzicht (met de nodige ornamenten)
 /// met de snelheid van de opgegeven sorteermethode *this. Er wordt 1 lijn uitgedrukt voor elke mogelijke
@@ -32,60 +52,172 @@ class Sorteermethode{
 /// zodat bv.
 ///    T a=5;
 /// geldig is.
-	void meet(int kortste, int langste, std::ostream& os, CsvData& csv) const;
+/// Als resultaten gegeven is, wordt elke lijn ook als record (zie meetkolommen()) met naam
+/// als sorteermethode aan dat binaire bestand toegevoegd.
+/// Als controleer waar is, wordt elk resultaat gecontroleerd (zie meet_lengte).
+	void meet(int kortste, int langste, std::ostream& os, CsvData& csv,
+	          Resultaatbestand* resultaten = nullptr, const std::string& naam = "", bool controleer = false) const;
+
+/// \fn meet_lengte geeft de tijden voor een random, gesorteerde en omgekeerde tabel van
+/// aantal_elementen elementen (een lijn van meet, zonder uitvoer)
+/// Met controleer wordt na elke sortering, buiten de tijdsmeting, nagegaan dat het resultaat
+/// correct is (is_correct) en een permutatie is van de invoer (Vingerafdruk). Voor een stabiele
+/// sorteermethode wordt ook de stabiliteit getest op gelabelde sleutels (hoogstens
+/// max_stabiliteitstest elementen). Een fout wordt als const char* gegooid.
+	std::array<double, 3> meet_lengte(int aantal_elementen, bool controleer = false) const;
+
+/// \fn is_correct controleert het resultaat van een sortering; een afgeleide klasse die niet
+/// volledig sorteert (bv. een selectie) kan dit verbergen met een eigen is_correct
+	template <typename It>
+	static bool is_correct(It begin, It end);
+
+/// stabiel: een afgeleide klasse die stabiel sorteert zet dit op true, dan wordt dat ook gecontroleerd
+	static constexpr bool stabiel = false;
+	static constexpr int max_stabiliteitstest = 1 << 20;
+
+/// \fn schrijf_hoofding en bewaar schrijven de hoofding en een lijn van meet weg, samen met
+/// de csv en het optionele resultaatbestand; ook bruikbaar voor metingen buiten meet
+	static void schrijf_hoofding(std::ostream& os);
+	static void bewaar(int aantal_elementen, const std::array<double, 3>& tijden, std::ostream& os, CsvData& csv,
+	                   Resultaatbestand* resultaten, const std::string& naam);
+
+	static constexpr int FIELD_WIDTH = 20;
 };
 
-template <typename T>
-void Sorteermethode<T>::meet(int kortste, int langste, std::ostream& os, CsvData& csv) const
+template <typename T, typename Afgeleide>
+void Sorteermethode<T, Afgeleide>::operator()(vector<T> & v) const
+{
+    (*this)(v.begin(), v.end());
+}
+
+template <typename T, typename Afgeleide>
+template <typename RandomIt, typename>
+void Sorteermethode<T, Afgeleide>::operator()(RandomIt begin, RandomIt end) const
+{
+    static_cast<const Afgeleide&>(*this).sorteer(begin, end);
+}
+
+template <typename T, typename Afgeleide>
+std::array<double, 3> Sorteermethode<T, Afgeleide>::meet_lengte(int aantal_elementen, bool controleer) const
 {
-    constexpr int FIELD_WIDTH = 20;
     Chrono timer;
+    std::array<double, 3> tijden;
+    Vingerafdruk voor;
+
+    Sortvector<T> data(aantal_elementen);
+
+    auto meet_en_controleer = [&](double& tijd) {
+        if (controleer)
+        {
+            voor = vingerafdruk(data.begin(), data.end());
+        }
 
+        timer.start();
+        (*this)(data);
+        timer.stop();
+
+        tijd = timer.tijd();
+
+        if (controleer)
+        {
+            if (!Afgeleide::is_correct(data.begin(), data.end()))
+            {
+                throw "Controle mislukt: resultaat is niet gesorteerd";
+            }
+            if (vingerafdruk(data.begin(), data.end()) != voor)
+            {
+                throw "Controle mislukt: resultaat is geen permutatie van de invoer";
+            }
+        }
+    };
+
+    data.vul_random();
+    meet_en_controleer(tijden[0]);
+
+    data.vul_range();
+    meet_en_controleer(tijden[1]);
+
+    data.vul_omgekeerd();
+    meet_en_controleer(tijden[2]);
+
+    // enkel instantieren voor stabiele methodes: de andere hoeven niet met Gelabeld<T> te werken
+    if constexpr (Afgeleide::stabiel)
+    {
+        if (controleer &&
+            !is_stabiel<T>(static_cast<const Afgeleide&>(*this), std::min(aantal_elementen, max_stabiliteitstest)))
+        {
+            throw "Controle mislukt: sortering is niet stabiel";
+        }
+    }
+
+    return tijden;
+}
+
+template <typename T, typename Afgeleide>
+template <typename It>
+bool Sorteermethode<T, Afgeleide>::is_correct(It begin, It end)
+{
+    return std::is_sorted(begin, end);
+}
+
+template <typename T, typename Afgeleide>
+void Sorteermethode<T, Afgeleide>::schrijf_hoofding(std::ostream& os)
+{
     os << std::setw(FIELD_WIDTH) << "lengte" << std::setw(FIELD_WIDTH) << "random" << std::setw(FIELD_WIDTH)
        << "gesorteerd" << std::setw(FIELD_WIDTH) << "omgekeerd" << std::endl
        << std::endl;
+}
+
+template <typename T, typename Afgeleide>
+void Sorteermethode<T, Afgeleide>::bewaar(int aantal_elementen, const std::array<double, 3>& tijden, std::ostream& os,
+                                          CsvData& csv, Resultaatbestand* resultaten, const std::string& naam)
+{
+    for (double tijd : tijden)
+    {
+        os << std::setw(FIELD_WIDTH) << tijd;
+    }
+    os << std::endl;
+
+    csv.voeg_data_toe(std::vector<double>{static_cast<double>(aantal_elementen), tijden[0], tijden[1], tijden[2]});
+
+    if (resultaten)
+    {
+        resultaten->voeg_toe({naam, static_cast<std::int64_t>(aantal_elementen), tijden[0], tijden[1], tijden[2]});
+    }
+}
+
+template <typename T, typename Afgeleide>
+void Sorteermethode<T, Afgeleide>::meet(int kortste, int langste, std::ostream& os, CsvData& csv,
+                             Resultaatbestand* resultaten, const std::string& naam, bool controleer) const
+{
+    schrijf_hoofding(os);
 
     int aantal_elementen = kortste;
     while (aantal_elementen < langste)
     {
         os << std::setw(FIELD_WIDTH) << aantal_elementen;
-		
-        Sortvector<T> data(aantal_elementen);
-        
-        data.vul_random();
-        
-        timer.start();
-        (*this)(data);
-        timer.stop();
-        
-        double tijd_random = timer.tijd();
-        os << std::setw(FIELD_WIDTH) << tijd_random;
-        
-        data.vul_range();
-        
-        timer.start();
-        (*this)(data);
-        timer.stop();
-        
-        double tijd_gesorteerd = timer.tijd();
-        os << std::setw(FIELD_WIDTH) << tijd_gesorteerd;
-        
-        data.vul_omgekeerd();
-        
-        timer.start();
-        (*this)(data);
-        timer.stop();
-        
-        double tijd_omgekeerd_gesorteerd = timer.tijd();
-        os << std::setw(FIELD_WIDTH) << tijd_omgekeerd_gesorteerd;
-        
-        csv.voeg_data_toe(std::vector<double>{
-                static_cast<double>(aantal_elementen), tijd_random, tijd_gesorteerd, tijd_omgekeerd_gesorteerd});
-        
+
+        bewaar(aantal_elementen, meet_lengte(aantal_elementen, controleer), os, csv, resultaten, naam);
+
         aantal_elementen *= 10;
-        
-        os << std::endl;
     }
 }
 
+/** class Sorteerlijst
+    \brief compile-time lijst van sorteermethodes (klassetemplates in T)
+    voor_elke<T>(f) roept f op met een object van elke sorteermethode, geinstantieerd voor T.
+    met<...> is dezelfde lijst, aangevuld met extra sorteermethodes.
+*/
+template <template <typename> class... Sorteermethoden>
+struct Sorteerlijst{
+    template <template <typename> class... Extra>
+    using met = Sorteerlijst<Sorteermethoden..., Extra...>;
+
+    template <typename T, typename Functie>
+    static void voor_elke(Functie&& f)
+    {
+        (f(Sorteermethoden<T>{}), ...);
+    }
+};
+
 #endif 
@@ -9,6 +9,10 @@
 #include <iostream>
 #include <random>
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include "randomgenerator.h"
 using std::istream;
 using std::ostream;
 using std::move;
@@ -27,6 +31,8 @@ class Sortvector : public vector<T>{
     /// n verschillende Ts in random volgorde
     /// (zie hulplidfuncties)
     Sortvector(int);
+    /// \fn Constructor met seed: alle vul_-functies geven dan een reproduceerbare reeks
+    Sortvector(int, std::uint64_t seed);
     
     Sortvector(const Sortvector<T>& v) = delete;
     Sortvector<T>& operator=(const Sortvector<T>& v) = delete;
@@ -40,6 +46,20 @@ class Sortvector : public vector<T>{
     void shuffle();
     void vul_random_zonder_dubbels();
     void vul_random();
+
+    /// \fn zet_seed herstart de reeks random getallen voor alle volgende vul_-oproepen
+    void zet_seed(std::uint64_t seed);
+
+    /// \fn vul_weinig_uniek vul met random waarden uit slechts aantal_uniek verschillende waarden
+    void vul_weinig_uniek(int aantal_uniek);
+    /// \fn vul_zaagtand vul met 0...periode-1, 0...periode-1, ...
+    void vul_zaagtand(int periode);
+    /// \fn vul_orgelpijp vul met 0, 1, ..., n/2, ..., 1, 0
+    void vul_orgelpijp();
+    /// \fn vul_bijna_gesorteerd vul_range gevolgd door aantal_wissels random verwisselingen
+    void vul_bijna_gesorteerd(int aantal_wissels);
+    /// \fn vul_zipf vul met Zipf-verdeelde waarden in [0, size()): waarde k heeft kans evenredig met 1/(k+1)^s
+    void vul_zipf(double s = 1.0);
     
     bool is_gesorteerd() const;
     /// \fn is_range controleert of *this eruit ziet als het resultaat van vul_range(), d.w.z.
@@ -53,11 +73,20 @@ class Sortvector : public vector<T>{
 
   private: 
     void schrijf(ostream & os)const;
-    
+
+    /// \fn volgende_seed geeft een nieuwe seed voor een (parallelle) vul_-oproep
+    std::uint64_t volgende_seed();
+
+    Xoshiro256 rng;
 };
 
 template <class T>
-Sortvector<T>::Sortvector(int grootte) : std::vector<T>(grootte)
+Sortvector<T>::Sortvector(int grootte) : Sortvector(grootte, std::random_device{}())
+{
+}
+
+template <class T>
+Sortvector<T>::Sortvector(int grootte, std::uint64_t seed) : std::vector<T>(grootte), rng{seed}
 {
     if (grootte > 0)
     {
@@ -65,6 +94,18 @@ Sortvector<T>::Sortvector(int grootte) : std::vector<T>(grootte)
     }
 }
 
+template <class T>
+void Sortvector<T>::zet_seed(std::uint64_t seed)
+{
+    rng = Xoshiro256{seed};
+}
+
+template <class T>
+std::uint64_t Sortvector<T>::volgende_seed()
+{
+    return rng();
+}
+
 template <class T>
 void Sortvector<T>::vul_range()
 {
@@ -92,10 +133,7 @@ void Sortvector<T>::vul_omgekeerd()
 template <class T>
 void Sortvector<T>::shuffle()
 {
-//	auto rng = std::default_random_engine{};
-//	std::shuffle(this->begin(), this->end(), rng);
-//	OR
-	std::random_shuffle(this->begin(), this->end());
+	std::shuffle(this->begin(), this->end(), rng);
 }
 
 template <class T>
@@ -113,13 +151,95 @@ void Sortvector<T>::vul_random()
         return;
     }
 
-    std::random_device rd;
-    std::mt19937 eng{rd()};
     const auto max_value = (this->size() - 1);
     assert(max_value < std::numeric_limits<int>::max());
-    std::uniform_int_distribution<int> dist{0, static_cast<int>(max_value)};
+    const std::uint64_t n = this->size();
+
+    vul_parallel(this->begin(), this->end(), volgende_seed(), [n](auto van, auto tot, Xoshiro256& blok_rng) {
+        for (auto it = van; it != tot; ++it)
+        {
+            *it = static_cast<int>(blok_rng.begrensd(n));
+        }
+    });
+}
+
+template <class T>
+void Sortvector<T>::vul_weinig_uniek(int aantal_uniek)
+{
+    assert(aantal_uniek > 0);
+
+    // spreid de unieke waarden over [0, size()) zodat de sleutels even groot blijven als bij vul_random
+    const std::uint64_t k = aantal_uniek;
+    const std::uint64_t stap = std::max<std::uint64_t>(1, this->size() / k);
+
+    vul_parallel(this->begin(), this->end(), volgende_seed(), [k, stap](auto van, auto tot, Xoshiro256& blok_rng) {
+        for (auto it = van; it != tot; ++it)
+        {
+            *it = static_cast<int>(blok_rng.begrensd(k) * stap);
+        }
+    });
+}
+
+template <class T>
+void Sortvector<T>::vul_zaagtand(int periode)
+{
+    assert(periode > 0);
+
+    int i = 0;
+    std::generate(this->begin(), this->end(), [&i, periode]() {
+        int waarde = i++;
+        if (i == periode)
+        {
+            i = 0;
+        }
+        return waarde;
+    });
+}
+
+template <class T>
+void Sortvector<T>::vul_orgelpijp()
+{
+    const int n = this->size();
+    for (int i = 0; i < n; i++)
+    {
+        (*this)[i] = std::min(i, n - 1 - i);
+    }
+}
+
+template <class T>
+void Sortvector<T>::vul_bijna_gesorteerd(int aantal_wissels)
+{
+    this->vul_range();
+
+    if (this->size() < 2)
+    {
+        return;
+    }
+
+    for (int i = 0; i < aantal_wissels; i++)
+    {
+        auto a = rng.begrensd(this->size());
+        auto b = rng.begrensd(this->size());
+        swap((*this)[a], (*this)[b]);
+    }
+}
+
+template <class T>
+void Sortvector<T>::vul_zipf(double s)
+{
+    if (this->empty())
+    {
+        return;
+    }
+
+    const Zipfverdeling zipf(this->size(), s);
 
-    std::generate(this->begin(), this->end(), [&dist, &rd]() { return dist(rd); });
+    vul_parallel(this->begin(), this->end(), volgende_seed(), [&zipf](auto van, auto tot, Xoshiro256& blok_rng) {
+        for (auto it = van; it != tot; ++it)
+        {
+            *it = static_cast<int>(zipf(blok_rng) - 1);
+        }
+    });
 }
 
 template <class T>
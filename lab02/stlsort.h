@@ -5,15 +5,18 @@
 #include <algorithm>
 
 template <typename T>
-class STLSort : public Sorteermethode<T>{
+class STLSort : public Sorteermethode<T, STLSort<T>>{
     public:
-        void operator()(vector<T> & v) const;
+        static constexpr const char* naam = "STL sort";
+
+        template <typename RandomIt>
+        void sorteer(RandomIt begin, RandomIt end) const;
 };
 
 template <typename T>
-void STLSort<T>::operator()(vector<T> & v) const{
-    sort(v.begin(), v.end());
+template <typename RandomIt>
+void STLSort<T>::sorteer(RandomIt begin, RandomIt end) const{
+    std::sort(begin, end);
 }
 
 #endif
-
@@ -0,0 +1,149 @@
+#include "resultaatbestand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+ Vergelijkt twee resultaatbestanden (zie resultaatbestand.h), bv. van twee commits:
+
+    vergelijk oud.sortres nieuw.sortres [drempel]
+
+ Records met dezelfde tekst- en gehele kolommen (bij meet: sorteermethode en lengte) horen bij
+ elkaar. Omdat een bestand meerdere runs kan bevatten, wordt per sleutel het minimum van elke
+ reele kolom genomen. Een meting is een regressie als nieuw/oud - 1 groter is dan de drempel
+ (standaard 0.10). Het programma eindigt met code 1 als er minstens 1 regressie is.
+*/
+
+using Sleutel = std::vector<std::string>;
+using Metingen = std::map<Sleutel, std::vector<double>>;
+
+Metingen lees_minima(const Resultaatlezer& lezer)
+{
+    const auto& kolommen = lezer.geef_kolommen();
+    Metingen minima;
+
+    for (std::size_t r = 0; r < lezer.aantal_records(); r++)
+    {
+        Sleutel sleutel;
+        std::vector<double> waarden;
+
+        for (int k = 0; k < kolommen.size(); k++)
+        {
+            switch (kolommen[k].type)
+            {
+            case Kolomtype::tekst:
+                sleutel.push_back(lezer.tekst(r, k));
+                break;
+            case Kolomtype::geheel:
+                sleutel.push_back(std::to_string(lezer.geheel(r, k)));
+                break;
+            case Kolomtype::reeel:
+                waarden.push_back(lezer.reeel(r, k));
+                break;
+            }
+        }
+
+        auto [it, nieuw] = minima.emplace(sleutel, waarden);
+        if (!nieuw)
+        {
+            for (int i = 0; i < waarden.size(); i++)
+            {
+                it->second[i] = std::min(it->second[i], waarden[i]);
+            }
+        }
+    }
+
+    return minima;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "gebruik: " << argv[0] << " oud.sortres nieuw.sortres [drempel]" << std::endl;
+        return 2;
+    }
+
+    const double drempel = (argc > 3) ? std::atof(argv[3]) : 0.10;
+
+    try
+    {
+        Resultaatlezer oud(argv[1]);
+        Resultaatlezer nieuw(argv[2]);
+
+        // de sleutels en de reele kolommen worden per positie vergeleken, dus naam en type moeten overal gelijk zijn
+        const auto& kolommen = oud.geef_kolommen();
+        const auto& kolommen_nieuw = nieuw.geef_kolommen();
+        const bool zelfde_kolommen =
+            std::equal(kolommen.begin(), kolommen.end(), kolommen_nieuw.begin(), kolommen_nieuw.end(),
+                       [](const Kolom& a, const Kolom& b) { return a.naam == b.naam && a.type == b.type; });
+        if (!zelfde_kolommen)
+        {
+            std::cerr << "de bestanden hebben andere kolommen" << std::endl;
+            return 2;
+        }
+
+        std::vector<std::string> reele_kolommen;
+        for (const auto& kolom : kolommen)
+        {
+            if (kolom.type == Kolomtype::reeel)
+            {
+                reele_kolommen.push_back(kolom.naam);
+            }
+        }
+
+        const Metingen metingen_oud = lees_minima(oud);
+        const Metingen metingen_nieuw = lees_minima(nieuw);
+
+        constexpr int FIELD_WIDTH = 20;
+        int aantal_regressies = 0;
+
+        for (const auto& [sleutel, waarden_nieuw] : metingen_nieuw)
+        {
+            auto it = metingen_oud.find(sleutel);
+            if (it == metingen_oud.end())
+            {
+                continue;
+            }
+
+            std::string label;
+            for (const auto& deel : sleutel)
+            {
+                label += deel + " ";
+            }
+
+            for (int i = 0; i < waarden_nieuw.size(); i++)
+            {
+                const double waarde_oud = it->second[i];
+                const double verschil = (waarde_oud > 0) ? (waarden_nieuw[i] / waarde_oud - 1)
+                                                         : std::numeric_limits<double>::quiet_NaN();
+                const bool regressie = verschil > drempel;
+
+                if (regressie)
+                {
+                    aantal_regressies++;
+                }
+
+                std::cout << std::left << std::setw(2 * FIELD_WIDTH) << label << std::setw(FIELD_WIDTH)
+                          << reele_kolommen[i] << std::right << std::setw(FIELD_WIDTH) << waarde_oud
+                          << std::setw(FIELD_WIDTH) << waarden_nieuw[i] << std::setw(FIELD_WIDTH) << std::fixed
+                          << std::setprecision(1) << 100 * verschil << '%' << std::defaultfloat
+                          << std::setprecision(6) << (regressie ? "  REGRESSIE" : "") << std::endl;
+            }
+        }
+
+        std::cout << std::endl << aantal_regressies << " regressie(s) boven " << 100 * drempel << '%' << std::endl;
+        return (aantal_regressies > 0) ? 1 : 0;
+    }
+    catch (const char* fout)
+    {
+        std::cerr << fout << std::endl;
+        return 2;
+    }
+}
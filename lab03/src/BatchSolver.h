@@ -0,0 +1,209 @@
+#ifndef BATCHSOLVER_H
+#define BATCHSOLVER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Sudoku.h"
+#include "SearchStats.h"
+#include "PropagatingSolver.h"
+#include "PuzzleLoader.h"
+#include "ThreadPool.h"
+
+// Where the sudokus of a batch come from: either a list of files with one sudoku each (like sudokus/1.txt to
+// 50.txt), one stream with any number of sudokus after each other (81 values each, separated by
+// whitespace), or grids that are already loaded (see loadPuzzles). Files and streams are read on demand, so
+// a batch never has to fit in memory.
+class PuzzleStream {
+public:
+    explicit PuzzleStream(const std::vector<std::string> &filenames);
+    explicit PuzzleStream(std::istream &in);
+    explicit PuzzleStream(const std::vector<PackedGrid> &grids);
+
+    // append up to count sudokus to batch, returns how many were read (0 at the end)
+    // throws std::runtime_error like Sudoku(filename) for a missing or short file
+    int read(std::vector<Sudoku> &batch, int count);
+
+private:
+    std::vector<std::string> filenames;
+    int nextFile = 0;
+    std::istream *in = nullptr;
+    const std::vector<PackedGrid> *grids = nullptr;
+    size_t nextGrid = 0;
+};
+
+PuzzleStream::PuzzleStream(const std::vector<std::string> &filenames) : filenames(filenames) {
+}
+
+PuzzleStream::PuzzleStream(std::istream &in) : in(&in) {
+}
+
+PuzzleStream::PuzzleStream(const std::vector<PackedGrid> &grids) : grids(&grids) {
+}
+
+int PuzzleStream::read(std::vector<Sudoku> &batch, int count) {
+    int added = 0;
+    while (added < count) {
+        if (in) {
+            // stop at the end of the stream, an incomplete sudoku at the end is ignored
+            Sudoku s(*in);
+            if (!*in) {
+                break;
+            }
+            batch.push_back(s);
+        } else if (grids) {
+            if (nextGrid == grids->size()) {
+                break;
+            }
+            batch.push_back((*grids)[nextGrid++].toSudoku());
+        } else {
+            if (nextFile == (int) filenames.size()) {
+                break;
+            }
+            batch.push_back(Sudoku(filenames[nextFile++]));
+        }
+        added++;
+    }
+    return added;
+}
+
+// The aggregated result of a batch. Every sudoku ends up in exactly one chunk and the totals are integer sums,
+// so the result does not depend on the number of threads, on which thread solved what or on the order in
+// which the chunks finished.
+struct BatchResult {
+    long long puzzles = 0;
+    long long solved = 0;
+    // sum of sumOfThreeFirstCells over the solved sudokus
+    long long sum = 0;
+    SearchStats stats;
+    double seconds = 0;
+
+    double puzzlesPerSecond() const { return seconds > 0 ? puzzles / seconds : 0; }
+};
+
+// Solves all sudokus of a stream on a work-stealing thread pool.
+// The stream is read in chunks of chunkSize sudokus, every chunk is one task. To keep the memory bounded there
+// are a fixed number of chunk slots (a few per thread). The calling thread reads the next chunk into a free
+// slot as long as there is one, so reading overlaps with solving. When all slots are in use it waits for any
+// chunk to finish, adds its result to the total and reuses that slot: a hard sudoku only holds up its own
+// slot, not the chunks around it.
+// Solver can be any of the solvers with a constructor taking a Sudoku, solve(), copyTo() and getStats().
+template <typename Solver = PropagatingSolver>
+class BatchSolver {
+public:
+    explicit BatchSolver(int threadCount = std::thread::hardware_concurrency(), int chunkSize = 64);
+
+    // if reading the stream throws, the chunks that are being solved are finished first, then it is rethrown
+    BatchResult solve(PuzzleStream &puzzles);
+
+private:
+    static void solveChunk(std::vector<Sudoku> &chunk, BatchResult &result);
+
+    ThreadPool pool;
+    int chunkSize;
+    int chunksInFlight;
+};
+
+template <typename Solver>
+BatchSolver<Solver>::BatchSolver(int threadCount, int chunkSize)
+    : pool(threadCount), chunkSize(chunkSize), chunksInFlight(8 * pool.size()) {
+}
+
+template <typename Solver>
+void BatchSolver<Solver>::solveChunk(std::vector<Sudoku> &chunk, BatchResult &result) {
+    for (Sudoku &s : chunk) {
+        Solver solver(s);
+        if (solver.solve()) {
+            solver.copyTo(s);
+        }
+
+        result.puzzles++;
+        result.stats.nodes += solver.getStats().nodes;
+        result.stats.backtracks += solver.getStats().backtracks;
+
+        int value = s.sumOfThreeFirstCells();
+        if (value != -1) {
+            result.solved++;
+            result.sum += value;
+        }
+    }
+}
+
+template <typename Solver>
+BatchResult BatchSolver<Solver>::solve(PuzzleStream &puzzles) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    BatchResult total;
+    std::vector<std::vector<Sudoku>> chunks(chunksInFlight);
+    std::vector<BatchResult> results(chunksInFlight);
+
+    std::vector<int> freeSlots;
+    for (int slot = chunksInFlight - 1; slot >= 0; slot--) {
+        freeSlots.push_back(slot);
+    }
+    // slots whose chunk has been solved but not added to the total yet
+    std::mutex mutex;
+    std::condition_variable chunkFinished;
+    std::vector<int> finished;
+    int running = 0;
+    bool endOfStream = false;
+
+    while (true) {
+        while (!endOfStream && !freeSlots.empty()) {
+            int slot = freeSlots.back();
+            // reading can throw (a missing file, bad_alloc) and so can submit; the running chunks use the locals
+            // of this function, so they have to finish before the exception leaves it
+            try {
+                chunks[slot].clear();
+                if (puzzles.read(chunks[slot], chunkSize) == 0) {
+                    endOfStream = true;
+                    break;
+                }
+                results[slot] = BatchResult();
+                pool.submit([&, slot] {
+                    solveChunk(chunks[slot], results[slot]);
+                    // notify while holding the lock: once the slot is seen, solve may return and destroy
+                    // chunkFinished
+                    std::lock_guard<std::mutex> lock(mutex);
+                    finished.push_back(slot);
+                    chunkFinished.notify_one();
+                });
+            } catch (...) {
+                std::unique_lock<std::mutex> lock(mutex);
+                chunkFinished.wait(lock, [&finished, running] { return finished.size() == size_t(running); });
+                throw;
+            }
+            freeSlots.pop_back();
+            running++;
+        }
+        if (running == 0) {
+            break;
+        }
+
+        std::vector<int> ready;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            chunkFinished.wait(lock, [&finished] { return !finished.empty(); });
+            ready.swap(finished);
+        }
+        for (int slot : ready) {
+            total.puzzles += results[slot].puzzles;
+            total.solved += results[slot].solved;
+            total.sum += results[slot].sum;
+            total.stats.nodes += results[slot].stats.nodes;
+            total.stats.backtracks += results[slot].stats.backtracks;
+            freeSlots.push_back(slot);
+            running--;
+        }
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    total.seconds = std::chrono::duration<double>(stop - start).count();
+    return total;
+}
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef BITMASKSOLVER_H
+#define BITMASKSOLVER_H
+
+#include <cstdint>
+#include <type_traits>
+#include "Sudoku.h"
+#include "SearchStats.h"
+
+// A solver core that works on masks instead of rescanning the grid.
+// For every row, column and subgrid a mask keeps track of the values that are already used in it (bit v-1 is
+// set if value v is used). The candidates of a cell are then simply the values that are not used in its row,
+// column or subgrid: ~(row | col | box) & ALL_VALUES, and they are enumerated with ctz.
+// Assigning or unassigning a value only flips one bit in three masks, so nothing has to be rescanned
+// and the search itself does not allocate anything.
+//
+// N is the size of a subgrid, so N = 3 is the usual 9x9 sudoku (BitmaskSolver), N = 4 is 16x16 and N = 5 is
+// 25x25. The masks have one bit per value, their type is the smallest unsigned integer with N^2 bits, so for
+// 9x9 and 16x16 they are 16 bits and for 25x25 32 bits. The grid can be a Sudoku or a GeneralSudoku<N>,
+// anything with getCell(row, col) and setCell(row, col, value).
+template <int N>
+class BasicBitmaskSolver {
+public:
+    static constexpr int SIZE = N * N;
+    static constexpr int CELLS = SIZE * SIZE;
+
+    typedef std::conditional_t<SIZE <= 16, uint16_t, std::conditional_t<SIZE <= 32, uint32_t, uint64_t>> Mask;
+    static constexpr Mask ALL_VALUES = Mask(~Mask(0)) >> (8 * sizeof(Mask) - SIZE);
+
+    template <typename Grid>
+    explicit BasicBitmaskSolver(const Grid &s);
+    // false if the given values already contain a duplicate in a row, column or subgrid
+    bool isConsistent() const;
+    // backtracking over the empty cells in row-major order, like Sudoku::solve
+    // returns false if there is no solution or if the limits stopped the search (see getStats().aborted)
+    bool solve(const SearchLimits &limits = SearchLimits());
+    template <typename Grid>
+    void copyTo(Grid &s) const;
+
+    Mask candidates(int cell) const;
+    const SearchStats &getStats() const;
+
+    static int rowOf(int cell) { return cell / SIZE; }
+    static int colOf(int cell) { return cell % SIZE; }
+    static int boxOf(int cell) { return (cell / (SIZE * N)) * N + (cell % SIZE) / N; }
+
+protected:
+    // a cell index, one byte as long as the grid has at most 256 cells
+    typedef std::conditional_t<CELLS <= 256, uint8_t, uint16_t> Cell;
+
+    static int lowestValue(Mask m) { return __builtin_ctzll(m) + 1; }
+    static int count(Mask m) { return __builtin_popcountll(m); }
+
+    void assign(int cell, int value);
+    void unassign(int cell);
+
+    uint8_t grid[CELLS];
+    Mask rowMask[SIZE] = {0};
+    Mask colMask[SIZE] = {0};
+    Mask boxMask[SIZE] = {0};
+    bool consistent = true;
+    SearchStats stats;
+    SearchBudget budget;
+
+private:
+    bool search(int next);
+
+    // the unassigned cells at construction, in row-major order
+    Cell emptyCells[CELLS];
+    int emptyCount = 0;
+};
+
+typedef BasicBitmaskSolver<3> BitmaskSolver;
+
+template <int N>
+template <typename Grid>
+BasicBitmaskSolver<N>::BasicBitmaskSolver(const Grid &s) {
+    for (int cell = 0; cell < CELLS; cell++) {
+        int value = s.getCell(rowOf(cell), colOf(cell));
+        grid[cell] = 0;
+
+        if (value < 1 || value > SIZE) {
+            emptyCells[emptyCount++] = cell;
+        } else if (candidates(cell) & (Mask(1) << (value - 1))) {
+            assign(cell, value);
+        } else {
+            // the value is already used in the row, column or subgrid of this cell
+            consistent = false;
+            grid[cell] = value;
+        }
+    }
+}
+
+template <int N>
+bool BasicBitmaskSolver<N>::isConsistent() const {
+    return consistent;
+}
+
+template <int N>
+typename BasicBitmaskSolver<N>::Mask BasicBitmaskSolver<N>::candidates(int cell) const {
+    return ~(rowMask[rowOf(cell)] | colMask[colOf(cell)] | boxMask[boxOf(cell)]) & ALL_VALUES;
+}
+
+template <int N>
+void BasicBitmaskSolver<N>::assign(int cell, int value) {
+    Mask bit = Mask(1) << (value - 1);
+    grid[cell] = value;
+    rowMask[rowOf(cell)] |= bit;
+    colMask[colOf(cell)] |= bit;
+    boxMask[boxOf(cell)] |= bit;
+}
+
+template <int N>
+void BasicBitmaskSolver<N>::unassign(int cell) {
+    Mask bit = ~(Mask(1) << (grid[cell] - 1));
+    grid[cell] = 0;
+    rowMask[rowOf(cell)] &= bit;
+    colMask[colOf(cell)] &= bit;
+    boxMask[boxOf(cell)] &= bit;
+}
+
+template <int N>
+bool BasicBitmaskSolver<N>::solve(const SearchLimits &limits) {
+    budget = SearchBudget(limits);
+    bool solved = consistent && search(0);
+    stats.wallTime = budget.elapsed();
+    return solved;
+}
+
+template <int N>
+bool BasicBitmaskSolver<N>::search(int next) {
+    // if no more unassigned cells then the sudoku is solved
+    if (next == emptyCount) {
+        return true;
+    }
+
+    int cell = emptyCells[next];
+    if (next + 1 > stats.maxDepth) {
+        stats.maxDepth = next + 1;
+    }
+
+    // try every candidate, lowest value first; cand &= cand - 1 clears the lowest set bit
+    for (Mask cand = candidates(cell); cand != 0; cand &= cand - 1) {
+        assign(cell, lowestValue(cand));
+        stats.nodes++;
+
+        if (search(next + 1)) {
+            return true;
+        }
+
+        unassign(cell);
+        stats.backtracks++;
+        if (budget.exhausted(stats)) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+template <int N>
+const SearchStats &BasicBitmaskSolver<N>::getStats() const {
+    return stats;
+}
+
+template <int N>
+template <typename Grid>
+void BasicBitmaskSolver<N>::copyTo(Grid &s) const {
+    for (int cell = 0; cell < CELLS; cell++) {
+        s.setCell(rowOf(cell), colOf(cell), grid[cell]);
+    }
+}
+
+#endif
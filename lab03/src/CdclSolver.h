@@ -0,0 +1,401 @@
+#ifndef CDCLSOLVER_H
+#define CDCLSOLVER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Sudoku.h"
+#include "SearchStats.h"
+
+// The sudoku as a SAT problem, solved by a small conflict-driven clause learning (CDCL) core.
+//
+// There is a boolean variable for every value in every cell (9 * 81 = 729), and clauses that say that every
+// cell, row, column and subgrid has every value at least once and at most once. A given is a unit clause.
+// The solver decides one variable at a time and propagates the consequences with two watched literals per
+// clause: a clause is only looked at when one of its two watched literals becomes false, and then it either
+// finds a new literal to watch, implies its other watched literal, or is a conflict.
+// On a conflict the implication graph is walked back to the first unique implication point (1UIP). That
+// gives a new clause that is learned, so the same combination of decisions is never tried again, and the
+// search jumps back to the level where the clause implies something new instead of just undoing the last
+// decision. Variables that take part in conflicts get a higher activity and are decided first (VSIDS), and
+// the search restarts after a number of conflicts that follows the Luby sequence.
+//
+// Puzzles that are built against a fixed branching order (see anti_backtracking.txt) don't hurt this
+// solver: the order follows the conflicts. Learned clauses are never deleted, a sudoku needs too few of them.
+//
+// In the stats a node is a decision, a backtrack a conflict and maxDepth the highest decision level.
+class CdclSolver {
+public:
+    explicit CdclSolver(const Sudoku &s);
+
+    // returns false if there is no solution or if the limits stopped the search (see getStats().aborted)
+    bool solve(const SearchLimits &limits = SearchLimits());
+    // write the solution, or the given values if there is none
+    void copyTo(Sudoku &s) const;
+    const SearchStats &getStats() const;
+
+private:
+    static constexpr int VARIABLES = 729;
+    static constexpr uint8_t IS_FALSE = 0, IS_TRUE = 1, UNDEFINED = 2;
+    static constexpr int NO_REASON = -1;
+
+    // a literal is 2 * variable for "value in cell" and 2 * variable + 1 for its negation
+    static int literal(int cell, int value, bool positive) { return 2 * (cell * 9 + value - 1) + (positive ? 0 : 1); }
+    static int variableOf(int literal) { return literal >> 1; }
+    static long long luby(int i);
+
+    uint8_t valueOf(int literal) const;
+    int decisionLevel() const { return trailLimits.size(); }
+
+    // the clauses of an empty grid, built once and copied by every solver
+    struct ClauseDatabase {
+        // all clauses after each other, clause i is literals[clauseStart[i]] up to literals[clauseStart[i + 1]]
+        std::vector<int> literals;
+        std::vector<int> clauseStart{0};
+        // for every literal the clauses in which it is one of the two watched literals (the first two)
+        std::vector<std::vector<int>> watches;
+
+        void addClause(const std::vector<int> &clause);
+    };
+    static const ClauseDatabase &emptyGrid();
+
+    int *clause(int index) { return &database.literals[database.clauseStart[index]]; }
+    int clauseSize(int index) const { return database.clauseStart[index + 1] - database.clauseStart[index]; }
+
+    void enqueue(int literal, int reason);
+    // the index of a conflicting clause, or -1
+    int propagate();
+    // the learned clause starts with the literal that it implies after jumping back to backjumpLevel
+    void analyze(int conflict, std::vector<int> &learned, int &backjumpLevel);
+    void backtrackTo(int level);
+    int pickBranchLiteral() const;
+    void bumpActivity(int variable);
+
+    Sudoku given;
+    bool consistent = true;
+
+    ClauseDatabase database;
+
+    uint8_t assigns[VARIABLES];
+    int level[VARIABLES];
+    int reason[VARIABLES];
+    bool savedPhase[VARIABLES];
+    double activity[VARIABLES];
+    bool seen[VARIABLES];
+    double activityIncrement = 1;
+
+    // assigned literals in order, trailLimits[l] is where decision level l + 1 starts
+    std::vector<int> trail;
+    std::vector<int> trailLimits;
+    size_t propagateHead = 0;
+
+    SearchStats stats;
+    SearchBudget budget;
+};
+
+void CdclSolver::ClauseDatabase::addClause(const std::vector<int> &clause) {
+    int index = clauseStart.size() - 1;
+    literals.insert(literals.end(), clause.begin(), clause.end());
+    clauseStart.push_back(literals.size());
+    watches[clause[0]].push_back(index);
+    watches[clause[1]].push_back(index);
+}
+
+const CdclSolver::ClauseDatabase &CdclSolver::emptyGrid() {
+    static const ClauseDatabase database = [] {
+        ClauseDatabase d;
+        d.watches.resize(2 * VARIABLES);
+
+        // for every cell and every row, column and subgrid with a value: at least one, and at most one
+        std::vector<int> group(9);
+        for (int kind = 0; kind < 4; kind++) {
+            for (int a = 0; a < 9; a++) {
+                for (int b = 0; b < 9; b++) {
+                    for (int i = 0; i < 9; i++) {
+                        int row, col, value;
+                        if (kind == 0) {
+                            row = a, col = b, value = i + 1;
+                        } else if (kind == 1) {
+                            row = a, col = i, value = b + 1;
+                        } else if (kind == 2) {
+                            row = i, col = a, value = b + 1;
+                        } else {
+                            row = (a / 3) * 3 + i / 3, col = (a % 3) * 3 + i % 3, value = b + 1;
+                        }
+                        group[i] = literal(row * 9 + col, value, true);
+                    }
+
+                    d.addClause(group);
+                    for (int i = 0; i < 9; i++) {
+                        for (int j = i + 1; j < 9; j++) {
+                            d.addClause({group[i] ^ 1, group[j] ^ 1});
+                        }
+                    }
+                }
+            }
+        }
+        return d;
+    }();
+    return database;
+}
+
+CdclSolver::CdclSolver(const Sudoku &s) : given(s), database(emptyGrid()) {
+    for (int v = 0; v < VARIABLES; v++) {
+        assigns[v] = UNDEFINED;
+        level[v] = 0;
+        reason[v] = NO_REASON;
+        savedPhase[v] = false;
+        activity[v] = 0;
+        seen[v] = false;
+    }
+
+    for (int cell = 0; cell < 81; cell++) {
+        int value = s.getCell(cell / 9, cell % 9);
+        if (value < 1 || value > 9) {
+            continue;
+        }
+        int given = literal(cell, value, true);
+        if (valueOf(given) == IS_FALSE) {
+            consistent = false;
+        } else if (valueOf(given) == UNDEFINED) {
+            enqueue(given, NO_REASON);
+        }
+    }
+}
+
+uint8_t CdclSolver::valueOf(int literal) const {
+    uint8_t value = assigns[variableOf(literal)];
+    return value == UNDEFINED ? UNDEFINED : value ^ (literal & 1);
+}
+
+void CdclSolver::enqueue(int literal, int reasonClause) {
+    int variable = variableOf(literal);
+    assigns[variable] = (literal & 1) ? IS_FALSE : IS_TRUE;
+    level[variable] = decisionLevel();
+    reason[variable] = reasonClause;
+    trail.push_back(literal);
+}
+
+int CdclSolver::propagate() {
+    while (propagateHead < trail.size()) {
+        int falseLiteral = trail[propagateHead++] ^ 1;
+        std::vector<int> &watching = database.watches[falseLiteral];
+
+        // the clauses that keep watching falseLiteral are compacted to the front
+        size_t kept = 0;
+        for (size_t i = 0; i < watching.size(); i++) {
+            int index = watching[i];
+            int *literals = clause(index);
+            int size = clauseSize(index);
+
+            // make sure the false literal is the second watch
+            if (literals[0] == falseLiteral) {
+                std::swap(literals[0], literals[1]);
+            }
+            if (valueOf(literals[0]) == IS_TRUE) {
+                watching[kept++] = index;
+                continue;
+            }
+
+            bool moved = false;
+            for (int k = 2; k < size; k++) {
+                if (valueOf(literals[k]) != IS_FALSE) {
+                    std::swap(literals[1], literals[k]);
+                    database.watches[literals[1]].push_back(index);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) {
+                continue;
+            }
+
+            watching[kept++] = index;
+            if (valueOf(literals[0]) == IS_FALSE) {
+                for (i++; i < watching.size(); i++) {
+                    watching[kept++] = watching[i];
+                }
+                watching.resize(kept);
+                propagateHead = trail.size();
+                return index;
+            }
+            enqueue(literals[0], index);
+            stats.propagations++;
+        }
+        watching.resize(kept);
+    }
+    return -1;
+}
+
+void CdclSolver::bumpActivity(int variable) {
+    activity[variable] += activityIncrement;
+    if (activity[variable] > 1e100) {
+        for (double &a : activity) {
+            a *= 1e-100;
+        }
+        activityIncrement *= 1e-100;
+    }
+}
+
+void CdclSolver::analyze(int conflict, std::vector<int> &learned, int &backjumpLevel) {
+    learned.assign(1, -1);
+    int pathCount = 0;
+    int implied = -1;
+    int index = trail.size() - 1;
+    int clauseIndex = conflict;
+
+    do {
+        const int *literals = clause(clauseIndex);
+        int size = clauseSize(clauseIndex);
+        // the first literal of a reason clause is the literal it implied
+        for (int k = (implied == -1 ? 0 : 1); k < size; k++) {
+            int variable = variableOf(literals[k]);
+            if (!seen[variable] && level[variable] > 0) {
+                seen[variable] = true;
+                bumpActivity(variable);
+                if (level[variable] >= decisionLevel()) {
+                    pathCount++;
+                } else {
+                    learned.push_back(literals[k]);
+                }
+            }
+        }
+
+        // the next literal of the current level on the trail that is part of the conflict
+        while (!seen[variableOf(trail[index])]) {
+            index--;
+        }
+        implied = trail[index--];
+        clauseIndex = reason[variableOf(implied)];
+        seen[variableOf(implied)] = false;
+        pathCount--;
+    } while (pathCount > 0);
+    learned[0] = implied ^ 1;
+
+    // jump back to the highest other level in the clause, and watch a literal of that level
+    backjumpLevel = 0;
+    for (size_t k = 1; k < learned.size(); k++) {
+        if (level[variableOf(learned[k])] > backjumpLevel) {
+            backjumpLevel = level[variableOf(learned[k])];
+            std::swap(learned[1], learned[k]);
+        }
+    }
+    for (int l : learned) {
+        seen[variableOf(l)] = false;
+    }
+    activityIncrement /= 0.95;
+}
+
+void CdclSolver::backtrackTo(int target) {
+    if (decisionLevel() <= target) {
+        return;
+    }
+    for (int i = trail.size() - 1; i >= trailLimits[target]; i--) {
+        int variable = variableOf(trail[i]);
+        savedPhase[variable] = (trail[i] & 1) == 0;
+        assigns[variable] = UNDEFINED;
+        reason[variable] = NO_REASON;
+    }
+    trail.resize(trailLimits[target]);
+    trailLimits.resize(target);
+    propagateHead = trail.size();
+}
+
+int CdclSolver::pickBranchLiteral() const {
+    int best = -1;
+    for (int v = 0; v < VARIABLES; v++) {
+        if (assigns[v] == UNDEFINED && (best == -1 || activity[v] > activity[best])) {
+            best = v;
+        }
+    }
+    return best == -1 ? -1 : 2 * best + (savedPhase[best] ? 0 : 1);
+}
+
+// 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+long long CdclSolver::luby(int i) {
+    int size = 1, sequence = 0;
+    while (size < i + 1) {
+        sequence++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != i) {
+        size = (size - 1) >> 1;
+        sequence--;
+        i = i % size;
+    }
+    return 1LL << sequence;
+}
+
+bool CdclSolver::solve(const SearchLimits &limits) {
+    budget = SearchBudget(limits);
+    if (!consistent || propagate() != -1) {
+        stats.wallTime = budget.elapsed();
+        return false;
+    }
+
+    const int restartUnit = 100;
+    int restarts = 0;
+    long long conflictsLeft = restartUnit * luby(restarts);
+    std::vector<int> learned;
+
+    while (true) {
+        int conflict = propagate();
+        if (conflict != -1) {
+            stats.backtracks++;
+            if (decisionLevel() == 0) {
+                stats.wallTime = budget.elapsed();
+                return false;
+            }
+
+            int backjumpLevel;
+            analyze(conflict, learned, backjumpLevel);
+            backtrackTo(backjumpLevel);
+            if (learned.size() == 1) {
+                enqueue(learned[0], NO_REASON);
+            } else {
+                database.addClause(learned);
+                enqueue(learned[0], database.clauseStart.size() - 2);
+            }
+
+            if (budget.exhausted(stats)) {
+                backtrackTo(0);
+                stats.wallTime = budget.elapsed();
+                return false;
+            }
+            if (--conflictsLeft == 0) {
+                backtrackTo(0);
+                conflictsLeft = restartUnit * luby(++restarts);
+            }
+        } else {
+            int decision = pickBranchLiteral();
+            if (decision == -1) {
+                stats.wallTime = budget.elapsed();
+                return true;
+            }
+
+            trailLimits.push_back(trail.size());
+            if (decisionLevel() > stats.maxDepth) {
+                stats.maxDepth = decisionLevel();
+            }
+            stats.nodes++;
+            enqueue(decision, NO_REASON);
+        }
+    }
+}
+
+void CdclSolver::copyTo(Sudoku &s) const {
+    s = given;
+    for (int cell = 0; cell < 81; cell++) {
+        for (int value = 1; value <= 9; value++) {
+            if (valueOf(literal(cell, value, true)) == IS_TRUE) {
+                s.setCell(cell / 9, cell % 9, value);
+            }
+        }
+    }
+}
+
+const SearchStats &CdclSolver::getStats() const {
+    return stats;
+}
+
+#endif
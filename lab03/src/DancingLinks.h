@@ -0,0 +1,226 @@
+#ifndef DANCINGLINKS_H
+#define DANCINGLINKS_H
+
+#include <cstdint>
+#include "Sudoku.h"
+#include "SearchStats.h"
+
+// A second sudoku engine: the sudoku as an exact cover problem, solved with Knuth's Algorithm X using
+// dancing links (DLX).
+// There are 324 constraints (columns) that each have to be covered exactly once:
+//   - every cell has a value                     (81)
+//   - every row contains every value             (81)
+//   - every column contains every value          (81)
+//   - every subgrid contains every value         (81)
+// and 729 possibilities (rows): value v in cell (r, c), each covering exactly 4 constraints.
+// All nodes live in one preallocated array and link to each other by index, so nothing is allocated
+// while searching. Covering or uncovering a column only relinks its neighbours.
+class DlxSolver {
+public:
+    explicit DlxSolver(const Sudoku &s);
+
+    // search for a first solution
+    bool solve();
+    // count the solutions, but stop as soon as limit solutions have been found
+    long long countSolutions(long long limit);
+    // write the first solution that was found (or the given values if there is none)
+    void copyTo(Sudoku &s) const;
+
+    const SearchStats &getStats() const;
+
+private:
+    static constexpr int COLUMNS = 324;
+    static constexpr int ROWS = 729;
+    static constexpr int ROOT = 0;
+    // node 0 is the root, 1..324 are the column headers, then 4 nodes for each row
+    static constexpr int NODES = 1 + COLUMNS + 4 * ROWS;
+
+    static int firstNode(int row) { return 1 + COLUMNS + 4 * row; }
+
+    void cover(int column);
+    void uncover(int column);
+    void search(int depth);
+
+    int left[NODES], right[NODES], up[NODES], down[NODES];
+    // column header of each node and number of nodes in each column
+    int16_t columnOf[NODES];
+    int16_t size[1 + COLUMNS];
+
+    bool consistent = true;
+    // the selected rows: first the givens, then the ones chosen by the search
+    int16_t selected[81];
+    int selectedCount = 0;
+    int givenCount = 0;
+
+    int16_t solution[81];
+    long long solutions = 0;
+    long long limit = 1;
+    SearchStats stats;
+};
+
+DlxSolver::DlxSolver(const Sudoku &s) {
+    // circular list of column headers
+    for (int c = 0; c <= COLUMNS; c++) {
+        left[c] = (c == 0) ? COLUMNS : c - 1;
+        right[c] = (c == COLUMNS) ? 0 : c + 1;
+        up[c] = down[c] = c;
+        columnOf[c] = c;
+        size[c] = 0;
+    }
+
+    for (int row = 0; row < ROWS; row++) {
+        int r = row / 81, c = (row / 9) % 9, v = row % 9;
+        int b = (r / 3) * 3 + c / 3;
+        int columns[4] = {1 + r * 9 + c, 1 + 81 + r * 9 + v, 1 + 162 + c * 9 + v, 1 + 243 + b * 9 + v};
+
+        int first = firstNode(row);
+        for (int i = 0; i < 4; i++) {
+            int node = first + i, column = columns[i];
+
+            // append at the bottom of the column
+            columnOf[node] = column;
+            up[node] = up[column];
+            down[node] = column;
+            down[up[column]] = node;
+            up[column] = node;
+            size[column]++;
+
+            // circular list of the 4 nodes of the row
+            left[node] = first + (i + 3) % 4;
+            right[node] = first + (i + 1) % 4;
+        }
+    }
+
+    // select the rows of the given values
+    bool covered[1 + COLUMNS] = {false};
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            int v = s.getCell(r, c);
+            if (v < 1 || v > 9) {
+                continue;
+            }
+
+            int row = r * 81 + c * 9 + (v - 1);
+            int first = firstNode(row);
+            for (int node = first; node < first + 4; node++) {
+                if (covered[columnOf[node]]) {
+                    // another given already covers this constraint
+                    consistent = false;
+                    return;
+                }
+            }
+            for (int node = first; node < first + 4; node++) {
+                covered[columnOf[node]] = true;
+                cover(columnOf[node]);
+            }
+            selected[selectedCount++] = row;
+        }
+    }
+    givenCount = selectedCount;
+}
+
+void DlxSolver::cover(int column) {
+    right[left[column]] = right[column];
+    left[right[column]] = left[column];
+
+    for (int i = down[column]; i != column; i = down[i]) {
+        for (int j = right[i]; j != i; j = right[j]) {
+            down[up[j]] = down[j];
+            up[down[j]] = up[j];
+            size[columnOf[j]]--;
+        }
+    }
+}
+
+void DlxSolver::uncover(int column) {
+    for (int i = up[column]; i != column; i = up[i]) {
+        for (int j = left[i]; j != i; j = left[j]) {
+            size[columnOf[j]]++;
+            down[up[j]] = j;
+            up[down[j]] = j;
+        }
+    }
+
+    right[left[column]] = column;
+    left[right[column]] = column;
+}
+
+void DlxSolver::search(int depth) {
+    // every constraint is covered: a solution
+    if (right[ROOT] == ROOT) {
+        if (solutions == 0) {
+            for (int i = 0; i < 81; i++) {
+                solution[i] = selected[i];
+            }
+        }
+        solutions++;
+        return;
+    }
+
+    // choose the column with the fewest remaining rows
+    int column = right[ROOT];
+    for (int c = right[column]; c != ROOT; c = right[c]) {
+        if (size[c] < size[column]) {
+            column = c;
+        }
+    }
+    if (size[column] == 0) {
+        return;
+    }
+    if (depth + 1 > stats.maxDepth) {
+        stats.maxDepth = depth + 1;
+    }
+
+    cover(column);
+    for (int i = down[column]; i != column && solutions < limit; i = down[i]) {
+        selected[selectedCount++] = (i - 1 - COLUMNS) / 4;
+        stats.nodes++;
+        for (int j = right[i]; j != i; j = right[j]) {
+            cover(columnOf[j]);
+        }
+
+        long long before = solutions;
+        search(depth + 1);
+
+        for (int j = left[i]; j != i; j = left[j]) {
+            uncover(columnOf[j]);
+        }
+        selectedCount--;
+        if (solutions == before) {
+            stats.backtracks++;
+        }
+    }
+    uncover(column);
+}
+
+bool DlxSolver::solve() {
+    return countSolutions(1) > 0;
+}
+
+long long DlxSolver::countSolutions(long long limit) {
+    if (!consistent) {
+        return 0;
+    }
+
+    this->limit = limit;
+    solutions = 0;
+    SearchBudget clock;
+    search(0);
+    stats.wallTime = clock.elapsed();
+    return solutions;
+}
+
+void DlxSolver::copyTo(Sudoku &s) const {
+    int count = (solutions > 0) ? 81 : givenCount;
+    const int16_t *rows = (solutions > 0) ? solution : selected;
+    for (int i = 0; i < count; i++) {
+        int row = rows[i];
+        s.setCell(row / 81, (row / 9) % 9, row % 9 + 1);
+    }
+}
+
+const SearchStats &DlxSolver::getStats() const {
+    return stats;
+}
+
+#endif
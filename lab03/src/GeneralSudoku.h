@@ -0,0 +1,189 @@
+#ifndef GENERALSUDOKU_H
+#define GENERALSUDOKU_H
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A sudoku of N^2 x N^2 cells with N x N subgrids, so N = 3 is the usual 9x9, N = 4 is 16x16 and N = 5 is
+// 25x25. Values go from 1 to N^2, 0 is an unassigned cell.
+//
+// The file format is the one of sudokus/1.txt, whitespace separated values in row-major order, so values
+// above 9 are written as numbers (10, 11, ...) and a file holds N^4 values. '.' is also accepted for an
+// unassigned cell. boxSizeOf(filename) finds N from the number of values, to choose the template argument.
+template <int N>
+class GeneralSudoku {
+public:
+    static constexpr int SIZE = N * N;
+    static constexpr int CELLS = SIZE * SIZE;
+
+    // an empty grid
+    GeneralSudoku();
+    // throws std::runtime_error if the file is missing or doesn't hold N^4 values
+    explicit GeneralSudoku(const std::string &filename);
+
+    int getCell(int row, int col) const { return grid[row * SIZE + col]; }
+    void setCell(int row, int col, int value) { grid[row * SIZE + col] = value; }
+
+    // a sudoku is solved if every row, column and subgrid holds every value exactly once
+    bool isSolved() const;
+
+    // a random puzzle with a solution: a solved grid from a fixed pattern with its rows, columns and values
+    // shuffled, of which about givens * N^4 cells are kept. The solution is not necessarily unique.
+    static GeneralSudoku generate(unsigned seed, double givens);
+
+    template <int M>
+    friend std::ostream &operator<<(std::ostream &out, const GeneralSudoku<M> &s);
+
+private:
+    uint8_t grid[CELLS] = {};
+};
+
+// number of values in the file, converted to N (3, 4 or 5), 0 if the count doesn't match a size
+int boxSizeOf(const std::string &filename) {
+    std::ifstream in(filename);
+    if (!in) {
+        throw std::runtime_error("cannot open " + filename);
+    }
+    long long count = 0;
+    std::string token;
+    while (in >> token) {
+        count++;
+    }
+    for (int n = 2; n <= 6; n++) {
+        if (count == n * n * n * n) {
+            return n;
+        }
+    }
+    return 0;
+}
+
+template <int N>
+GeneralSudoku<N>::GeneralSudoku() {
+}
+
+template <int N>
+GeneralSudoku<N>::GeneralSudoku(const std::string &filename) {
+    std::ifstream in(filename);
+    if (!in) {
+        throw std::runtime_error("cannot open " + filename);
+    }
+
+    std::string token;
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (!(in >> token)) {
+            throw std::runtime_error(filename + " does not contain " + std::to_string(CELLS) + " values");
+        }
+        if (token == ".") {
+            continue;
+        }
+        // stoi throws invalid_argument or out_of_range (both logic_errors) and ignores trailing characters
+        int value;
+        try {
+            size_t end;
+            value = std::stoi(token, &end);
+            if (end != token.size()) {
+                throw std::invalid_argument(token);
+            }
+        } catch (const std::logic_error &) {
+            throw std::runtime_error(filename + ": value " + token + " is not a number");
+        }
+        if (value < 0 || value > SIZE) {
+            throw std::runtime_error(filename + ": value " + token + " out of range");
+        }
+        grid[cell] = value;
+    }
+}
+
+template <int N>
+bool GeneralSudoku<N>::isSolved() const {
+    for (int unit = 0; unit < 3 * SIZE; unit++) {
+        // seen is indexed by value, seen[0] catches unassigned cells
+        bool seen[SIZE + 1] = {false};
+        for (int i = 0; i < SIZE; i++) {
+            int row, col;
+            if (unit < SIZE) {
+                row = unit;
+                col = i;
+            } else if (unit < 2 * SIZE) {
+                row = i;
+                col = unit - SIZE;
+            } else {
+                int box = unit - 2 * SIZE;
+                row = (box / N) * N + i / N;
+                col = (box % N) * N + i % N;
+            }
+
+            int value = getCell(row, col);
+            if (value == 0 || value > SIZE || seen[value]) {
+                return false;
+            }
+            seen[value] = true;
+        }
+    }
+    return true;
+}
+
+template <int N>
+GeneralSudoku<N> GeneralSudoku<N>::generate(unsigned seed, double givens) {
+    std::mt19937 rng(seed);
+
+    // rows and columns are shuffled within their band or stack, and the bands and stacks themselves too,
+    // that keeps every subgrid intact
+    auto shuffledLines = [&rng]() {
+        int bands[N], lines[SIZE];
+        std::iota(bands, bands + N, 0);
+        std::shuffle(bands, bands + N, rng);
+        for (int b = 0; b < N; b++) {
+            int inBand[N];
+            std::iota(inBand, inBand + N, 0);
+            std::shuffle(inBand, inBand + N, rng);
+            for (int i = 0; i < N; i++) {
+                lines[b * N + i] = bands[b] * N + inBand[i];
+            }
+        }
+        return std::vector<int>(lines, lines + SIZE);
+    };
+    std::vector<int> rows = shuffledLines();
+    std::vector<int> cols = shuffledLines();
+
+    std::vector<int> values(SIZE);
+    std::iota(values.begin(), values.end(), 1);
+    std::shuffle(values.begin(), values.end(), rng);
+
+    GeneralSudoku s;
+    std::bernoulli_distribution keep(givens);
+    for (int r = 0; r < SIZE; r++) {
+        for (int c = 0; c < SIZE; c++) {
+            // a solved grid: every row is the previous one shifted by N, and by one more at the start of a band
+            int row = rows[r], col = cols[c];
+            int value = values[(N * (row % N) + row / N + col) % SIZE];
+            s.setCell(r, c, keep(rng) ? value : 0);
+        }
+    }
+    return s;
+}
+
+template <int N>
+std::ostream &operator<<(std::ostream &out, const GeneralSudoku<N> &s) {
+    const int width = GeneralSudoku<N>::SIZE > 9 ? 3 : 2;
+    for (int r = 0; r < GeneralSudoku<N>::SIZE; r++) {
+        for (int c = 0; c < GeneralSudoku<N>::SIZE; c++) {
+            out << std::setw(width) << s.getCell(r, c);
+            if ((c + 1) % N == 0 && c + 1 < GeneralSudoku<N>::SIZE) {
+                out << " |";
+            }
+        }
+        out << std::endl;
+    }
+    return out;
+}
+
+#endif
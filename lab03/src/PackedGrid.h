@@ -0,0 +1,31 @@
+#ifndef PACKEDGRID_H
+#define PACKEDGRID_H
+
+#include <cstdint>
+#include "Sudoku.h"
+
+// a sudoku as 81 bytes in row-major order, 0 for an empty cell
+struct PackedGrid {
+    uint8_t cells[81];
+
+    Sudoku toSudoku() const;
+    static PackedGrid fromSudoku(const Sudoku &s);
+};
+
+Sudoku PackedGrid::toSudoku() const {
+    Sudoku s;
+    for (int cell = 0; cell < 81; cell++) {
+        s.setCell(cell / 9, cell % 9, cells[cell]);
+    }
+    return s;
+}
+
+PackedGrid PackedGrid::fromSudoku(const Sudoku &s) {
+    PackedGrid grid;
+    for (int cell = 0; cell < 81; cell++) {
+        grid.cells[cell] = s.getCell(cell / 9, cell % 9);
+    }
+    return grid;
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "Sudoku.h"
+#include "SearchStats.h"
+#include "CdclSolver.h"
+
+struct PortfolioResult {
+    bool solved = false;
+    // the solver that finished first, "none" if the limits stopped both
+    std::string winner = "none";
+    SearchStats stats;
+};
+
+// Races the backtracker of Sudoku::solve against CdclSolver, each on its own thread, on copies of s.
+// The first one that finishes, with a solution or with the proof that there is none, sets a shared flag
+// that makes the other one stop at its next check (see SearchBudget). s gets the solution of the winner.
+// The backtracker wins on easy puzzles because it doesn't have to build any clauses first, the CDCL solver
+// wins on puzzles that are built against a fixed branching order.
+PortfolioResult solvePortfolio(Sudoku &s, const SearchLimits &limits = SearchLimits()) {
+    std::atomic<bool> stop{false};
+    std::atomic<int> winner{-1};
+    SearchLimits shared = limits;
+    shared.stop = &stop;
+
+    // claim the win if the search came to an answer instead of being stopped
+    auto finish = [&](int solver, const SearchStats &stats) {
+        int none = -1;
+        if (!stats.aborted && winner.compare_exchange_strong(none, solver)) {
+            stop = true;
+        }
+    };
+
+    Sudoku backtracked = s;
+    SearchStats backtrackStats;
+    bool backtrackSolved = false;
+    std::thread backtracker([&] {
+        backtrackSolved = backtracked.solve(backtrackStats, shared);
+        finish(0, backtrackStats);
+    });
+
+    Sudoku learned = s;
+    CdclSolver cdcl(s);
+    bool cdclSolved = cdcl.solve(shared);
+    finish(1, cdcl.getStats());
+    backtracker.join();
+
+    PortfolioResult result;
+    if (winner == 0) {
+        result = {backtrackSolved, "backtracking", backtrackStats};
+        s = backtracked;
+    } else if (winner == 1) {
+        result = {cdclSolved, "CDCL", cdcl.getStats()};
+        cdcl.copyTo(learned);
+        s = learned;
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef PROPAGATINGSOLVER_H
+#define PROPAGATINGSOLVER_H
+
+#include <cstdint>
+#include "BitmaskSolver.h"
+
+// A solver that does inference before every branch instead of only backtracking:
+// - naked single: a cell with only one candidate gets that value
+// - hidden single: a value that fits in only one cell of a row, column or subgrid goes in that cell
+// Both rules are applied until nothing changes anymore (a fixpoint). Only then it branches, and it does so
+// on the most constrained cell (minimum remaining values), the empty cell with the fewest candidates.
+// Every assignment is pushed on a trail, so undoing a branch just pops the trail back to where it was.
+// Like BasicBitmaskSolver it works for any subgrid size N, PropagatingSolver is the one for 9x9.
+template <int N>
+class BasicPropagatingSolver : public BasicBitmaskSolver<N> {
+public:
+    typedef BasicBitmaskSolver<N> Base;
+    typedef typename Base::Mask Mask;
+    static constexpr int SIZE = Base::SIZE;
+    static constexpr int CELLS = Base::CELLS;
+
+    template <typename Grid>
+    explicit BasicPropagatingSolver(const Grid &s);
+    // if there is no solution or the limits stop the search, the grid is left as it was given
+    bool solve(const SearchLimits &limits = SearchLimits());
+
+    // the cells of unit u: rows are units 0 to SIZE-1, then the columns and then the subgrids
+    static int unitCell(int unit, int i);
+
+protected:
+    // apply naked and hidden singles until a fixpoint, false on a contradiction
+    bool propagate();
+    // empty cell with the fewest candidates, -1 if the grid is full
+    int mostConstrainedCell() const;
+
+    void assignOnTrail(int cell, int value);
+    void undoTrail(int mark);
+
+    typename Base::Cell trail[CELLS];
+    int trailSize = 0;
+
+private:
+    bool search(int depth);
+};
+
+typedef BasicPropagatingSolver<3> PropagatingSolver;
+
+template <int N>
+template <typename Grid>
+BasicPropagatingSolver<N>::BasicPropagatingSolver(const Grid &s) : Base(s) {
+}
+
+template <int N>
+int BasicPropagatingSolver<N>::unitCell(int unit, int i) {
+    if (unit < SIZE) {
+        return unit * SIZE + i;
+    }
+    if (unit < 2 * SIZE) {
+        return i * SIZE + (unit - SIZE);
+    }
+    int box = unit - 2 * SIZE;
+    return ((box / N) * N + i / N) * SIZE + (box % N) * N + i % N;
+}
+
+template <int N>
+void BasicPropagatingSolver<N>::assignOnTrail(int cell, int value) {
+    this->assign(cell, value);
+    trail[trailSize++] = cell;
+}
+
+template <int N>
+void BasicPropagatingSolver<N>::undoTrail(int mark) {
+    while (trailSize > mark) {
+        this->unassign(trail[--trailSize]);
+    }
+}
+
+template <int N>
+bool BasicPropagatingSolver<N>::propagate() {
+    const uint8_t *grid = this->grid;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        // naked singles
+        for (int cell = 0; cell < CELLS; cell++) {
+            if (grid[cell] != 0) {
+                continue;
+            }
+            Mask cand = this->candidates(cell);
+            if (cand == 0) {
+                return false;
+            }
+            if ((cand & (cand - 1)) == 0) {
+                assignOnTrail(cell, Base::lowestValue(cand));
+                this->stats.propagations++;
+                changed = true;
+            }
+        }
+
+        // hidden singles
+        for (int unit = 0; unit < 3 * SIZE; unit++) {
+            // once: values that fit in at least one empty cell of the unit, twice: in at least two
+            Mask used = 0, once = 0, twice = 0;
+            for (int i = 0; i < SIZE; i++) {
+                int cell = unitCell(unit, i);
+                if (grid[cell] != 0) {
+                    used |= Mask(1) << (grid[cell] - 1);
+                } else {
+                    Mask cand = this->candidates(cell);
+                    twice |= once & cand;
+                    once |= cand;
+                }
+            }
+
+            // a value that is not used and fits nowhere makes the sudoku unsolvable
+            if (Mask(used | once) != Base::ALL_VALUES) {
+                return false;
+            }
+
+            for (Mask single = once & ~twice; single != 0; single &= single - 1) {
+                Mask bit = single & -single;
+                for (int i = 0; i < SIZE; i++) {
+                    int cell = unitCell(unit, i);
+                    // the candidates can have changed by an earlier single in this unit
+                    if (grid[cell] == 0 && (this->candidates(cell) & bit)) {
+                        assignOnTrail(cell, Base::lowestValue(bit));
+                        this->stats.propagations++;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <int N>
+int BasicPropagatingSolver<N>::mostConstrainedCell() const {
+    int best = -1;
+    int bestCount = SIZE + 1;
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (this->grid[cell] == 0) {
+            int count = Base::count(this->candidates(cell));
+            if (count < bestCount) {
+                best = cell;
+                bestCount = count;
+                if (count <= 1) {
+                    break;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+template <int N>
+bool BasicPropagatingSolver<N>::solve(const SearchLimits &limits) {
+    this->budget = SearchBudget(limits);
+    bool solved = this->consistent && propagate() && search(1);
+    // a failed or aborted search has undone its branches, but not the values the root propagation derived
+    if (!solved) {
+        undoTrail(0);
+    }
+    this->stats.wallTime = this->budget.elapsed();
+    return solved;
+}
+
+template <int N>
+bool BasicPropagatingSolver<N>::search(int depth) {
+    SearchStats &stats = this->stats;
+    int cell = mostConstrainedCell();
+
+    // if no more unassigned cells then the sudoku is solved
+    if (cell == -1) {
+        return true;
+    }
+    if (depth > stats.maxDepth) {
+        stats.maxDepth = depth;
+    }
+
+    int mark = trailSize;
+    for (Mask cand = this->candidates(cell); cand != 0; cand &= cand - 1) {
+        assignOnTrail(cell, Base::lowestValue(cand));
+        stats.nodes++;
+
+        if (propagate() && search(depth + 1)) {
+            return true;
+        }
+
+        undoTrail(mark);
+        stats.backtracks++;
+        if (this->budget.exhausted(stats)) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+#endif
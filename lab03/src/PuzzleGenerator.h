@@ -0,0 +1,196 @@
+#ifndef PUZZLEGENERATOR_H
+#define PUZZLEGENERATOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Sudoku.h"
+#include "PackedGrid.h"
+#include "PropagatingSolver.h"
+#include "DancingLinks.h"
+
+// Which rule is needed to solve a sudoku, from easy to hard. The difficulty is the work the reference solver
+// (PropagatingSolver, MRV + singles) needs for it, see DifficultyRater.
+enum class Technique { nakedSingles, hiddenSingles, search };
+enum class Difficulty { easy, hard, pathological };
+
+struct Rating {
+    Technique technique;
+    // search statistics of the reference solver, nodes is 0 if the singles are enough
+    long long nodes;
+    long long backtracks;
+    long long propagations;
+    // propagations + BRANCH_COST * nodes
+    long long work;
+    Difficulty difficulty;
+};
+
+// Rates a sudoku in two ways:
+// - technique: solve it step by step, first with naked singles only, then with naked and hidden singles, and
+//   only if that still leaves empty cells with the full MRV search
+// - difficulty: the work of a fresh PropagatingSolver on the sudoku, as the number of values it derives by
+//   propagation plus BRANCH_COST per branching node. A node costs about as much as 8 propagations: it scans the
+//   grid for the most constrained cell and runs a full propagate. On generated sudokus this work predicts the
+//   solve time of PropagatingSolver well, the number of nodes or backtracks alone doesn't.
+// A sudoku without search is easy, with search it is hard, and pathological from PATHOLOGICAL_WORK on (about
+// the 10% hardest generated sudokus). The difficulty only says something about the reference solver: plain
+// backtracking in row-major order (BitmaskSolver) depends on where the givens are, not on the propagation.
+class DifficultyRater : public PropagatingSolver {
+public:
+    static constexpr long long BRANCH_COST = 8;
+    static constexpr long long PATHOLOGICAL_WORK = 150;
+
+    explicit DifficultyRater(const Sudoku &s);
+    Rating rate();
+
+private:
+    bool solvedByNakedSingles();
+    bool isFull() const;
+
+    Sudoku puzzle;
+};
+
+DifficultyRater::DifficultyRater(const Sudoku &s) : PropagatingSolver(s), puzzle(s) {
+}
+
+bool DifficultyRater::isFull() const {
+    return std::find(grid, grid + 81, 0) == grid + 81;
+}
+
+bool DifficultyRater::solvedByNakedSingles() {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int cell = 0; cell < 81; cell++) {
+            if (grid[cell] != 0) {
+                continue;
+            }
+            uint16_t cand = candidates(cell);
+            if (cand != 0 && (cand & (cand - 1)) == 0) {
+                assignOnTrail(cell, __builtin_ctz(cand) + 1);
+                changed = true;
+            }
+        }
+    }
+    return isFull();
+}
+
+Rating DifficultyRater::rate() {
+    PropagatingSolver reference(puzzle);
+    reference.solve();
+    const SearchStats &stats = reference.getStats();
+
+    Rating rating{Technique::search, stats.nodes, stats.backtracks, stats.propagations,
+                  stats.propagations + BRANCH_COST * stats.nodes, Difficulty::easy};
+    if (stats.nodes > 0) {
+        rating.difficulty = rating.work >= PATHOLOGICAL_WORK ? Difficulty::pathological : Difficulty::hard;
+    }
+
+    // naked singles never assign a wrong value, so the hidden singles can go on from here
+    if (solvedByNakedSingles()) {
+        rating.technique = Technique::nakedSingles;
+    } else if (propagate() && isFull()) {
+        rating.technique = Technique::hiddenSingles;
+    }
+    return rating;
+}
+
+// Generates sudokus with exactly one solution. Every sudoku only depends on the seed of the generator and its
+// index, so a corpus can be regenerated exactly, and any part of it on its own.
+//
+// A sudoku starts from a random solved grid: the three subgrids on the diagonal don't share a row or column,
+// so they are filled with independent random permutations and the solver completes the rest. Then the cells
+// are emptied in random order, and every cell whose removal would allow a second solution (dancing links
+// finds at least 2) is put back. The result is minimal: no given can be removed anymore.
+class PuzzleGenerator {
+public:
+    explicit PuzzleGenerator(uint64_t seed);
+
+    PackedGrid generate(uint64_t index) const;
+    // generate puzzles until every difficulty has count puzzles, or maxPuzzles have been tried
+    std::vector<std::vector<PackedGrid>> generateBuckets(int count, int maxPuzzles) const;
+
+    static Rating rate(const PackedGrid &puzzle);
+
+private:
+    uint64_t seed;
+};
+
+PuzzleGenerator::PuzzleGenerator(uint64_t seed) : seed(seed) {
+}
+
+PackedGrid PuzzleGenerator::generate(uint64_t index) const {
+    std::seed_seq sequence{uint32_t(seed), uint32_t(seed >> 32), uint32_t(index), uint32_t(index >> 32)};
+    std::mt19937 rng(sequence);
+
+    Sudoku s;
+    for (int box = 0; box < 3; box++) {
+        int values[9];
+        std::iota(values, values + 9, 1);
+        std::shuffle(values, values + 9, rng);
+        for (int i = 0; i < 9; i++) {
+            s.setCell(box * 3 + i / 3, box * 3 + i % 3, values[i]);
+        }
+    }
+    PropagatingSolver filler(s);
+    filler.solve();
+    filler.copyTo(s);
+
+    int order[81];
+    std::iota(order, order + 81, 0);
+    std::shuffle(order, order + 81, rng);
+    for (int cell : order) {
+        int value = s.getCell(cell / 9, cell % 9);
+        s.setCell(cell / 9, cell % 9, 0);
+        if (DlxSolver(s).countSolutions(2) != 1) {
+            s.setCell(cell / 9, cell % 9, value);
+        }
+    }
+    return PackedGrid::fromSudoku(s);
+}
+
+Rating PuzzleGenerator::rate(const PackedGrid &puzzle) {
+    return DifficultyRater(puzzle.toSudoku()).rate();
+}
+
+std::vector<std::vector<PackedGrid>> PuzzleGenerator::generateBuckets(int count, int maxPuzzles) const {
+    std::vector<std::vector<PackedGrid>> buckets(3);
+    for (int index = 0; index < maxPuzzles; index++) {
+        PackedGrid puzzle = generate(index);
+        std::vector<PackedGrid> &bucket = buckets[static_cast<int>(rate(puzzle).difficulty)];
+        if (bucket.size() < size_t(count)) {
+            bucket.push_back(puzzle);
+        }
+
+        bool full = true;
+        for (const std::vector<PackedGrid> &b : buckets) {
+            full = full && b.size() >= size_t(count);
+        }
+        if (full) {
+            break;
+        }
+    }
+    return buckets;
+}
+
+// write sudokus in the line format of PuzzleLoader.h, so loadPuzzles can read them back
+void writePuzzles(const std::string &filename, const std::vector<PackedGrid> &puzzles) {
+    std::ofstream out(filename);
+    if (!out) {
+        throw std::runtime_error("cannot write " + filename);
+    }
+    std::string line(82, '\n');
+    for (const PackedGrid &puzzle : puzzles) {
+        for (int cell = 0; cell < 81; cell++) {
+            line[cell] = puzzle.cells[cell] == 0 ? '.' : char('0' + puzzle.cells[cell]);
+        }
+        out << line;
+    }
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef PUZZLELOADER_H
+#define PUZZLELOADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "PackedGrid.h"
+
+// The line format used by most sudoku collections: one sudoku per line, 81 characters in row-major order,
+// '1'-'9' for a given value and '.' or '0' for an empty cell. A '\r' before the newline is allowed, empty
+// lines and lines starting with '#' are skipped.
+//
+// 003020600900305001001806400008102900700000008006708200002609500800203009005010300
+
+struct ParseError {
+    long long line;
+    std::string message;
+};
+
+// Parses a buffer in the line format. Lines that are not a valid sudoku are not added to the grids, they are
+// reported in errors with their line number (starting at 1) instead.
+class PuzzleParser {
+public:
+    // useSimd = false forces the scalar parser, to compare both
+    explicit PuzzleParser(bool useSimd = true);
+
+    void parse(const char *data, size_t size, std::vector<PackedGrid> &grids, std::vector<ParseError> &errors) const;
+
+    // parse exactly 81 characters into grid, returns the index of the first invalid character or -1
+    static int parseLineScalar(const char *line, PackedGrid &grid);
+#ifdef __SSE2__
+    static int parseLineSse2(const char *line, PackedGrid &grid);
+#endif
+
+private:
+    bool useSimd;
+};
+
+PuzzleParser::PuzzleParser(bool useSimd) : useSimd(useSimd) {
+}
+
+int PuzzleParser::parseLineScalar(const char *line, PackedGrid &grid) {
+    for (int i = 0; i < 81; i++) {
+        char c = line[i];
+        if (c >= '0' && c <= '9') {
+            grid.cells[i] = c - '0';
+        } else if (c == '.') {
+            grid.cells[i] = 0;
+        } else {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#ifdef __SSE2__
+// 16 characters at once: subtract '0', a character is a digit if the result is at most 9 as an unsigned byte
+// (everything below '0' wraps around to a large value), and a '.' becomes 0. The 81st character is done
+// separately, so nothing is read past the line.
+int PuzzleParser::parseLineSse2(const char *line, PackedGrid &grid) {
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i dot = _mm_set1_epi8('.');
+
+    for (int i = 0; i < 80; i += 16) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(line + i));
+        __m128i digits = _mm_sub_epi8(chars, zero);
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine);
+        __m128i isDot = _mm_cmpeq_epi8(chars, dot);
+
+        int valid = _mm_movemask_epi8(_mm_or_si128(isDigit, isDot));
+        if (valid != 0xFFFF) {
+            return i + __builtin_ctz(~valid);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(grid.cells + i), _mm_and_si128(digits, isDigit));
+    }
+
+    char last = line[80];
+    if (last >= '0' && last <= '9') {
+        grid.cells[80] = last - '0';
+    } else if (last == '.') {
+        grid.cells[80] = 0;
+    } else {
+        return 80;
+    }
+    return -1;
+}
+#endif
+
+void PuzzleParser::parse(const char *data, size_t size, std::vector<PackedGrid> &grids,
+                         std::vector<ParseError> &errors) const {
+    const char *end = data + size;
+    long long lineNumber = 0;
+
+    for (const char *line = data; line < end;) {
+        lineNumber++;
+        const char *newline = static_cast<const char *>(memchr(line, '\n', end - line));
+        const char *lineEnd = newline ? newline : end;
+        const char *next = newline ? newline + 1 : end;
+
+        size_t length = lineEnd - line;
+        if (length > 0 && line[length - 1] == '\r') {
+            length--;
+        }
+
+        if (length == 0 || line[0] == '#') {
+            line = next;
+            continue;
+        }
+        if (length != 81) {
+            errors.push_back({lineNumber, "expected 81 characters, got " + std::to_string(length)});
+            line = next;
+            continue;
+        }
+
+        PackedGrid grid;
+#ifdef __SSE2__
+        int invalid = useSimd ? parseLineSse2(line, grid) : parseLineScalar(line, grid);
+#else
+        int invalid = parseLineScalar(line, grid);
+#endif
+        if (invalid >= 0) {
+            errors.push_back({lineNumber, "invalid character '" + std::string(1, line[invalid]) + "' at column "
+                                              + std::to_string(invalid + 1)});
+        } else {
+            grids.push_back(grid);
+        }
+        line = next;
+    }
+}
+
+// A read-only memory mapping of a whole file, the parser reads straight from the page cache without copying
+// the file into a buffer first. Throws std::runtime_error if the file can't be opened or mapped.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data() const { return address; }
+    size_t size() const { return length; }
+
+private:
+    const char *address = nullptr;
+    size_t length = 0;
+};
+
+MappedFile::MappedFile(const std::string &filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + filename);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("cannot read the size of " + filename);
+    }
+    length = info.st_size;
+
+    if (length > 0) {
+        void *mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("cannot map " + filename);
+        }
+        // the file is read once from front to back
+        madvise(mapped, length, MADV_SEQUENTIAL);
+        address = static_cast<const char *>(mapped);
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (address) {
+        munmap(const_cast<char *>(address), length);
+    }
+}
+
+// load all sudokus of a file in the line format, see PuzzleParser for how errors are reported
+std::vector<PackedGrid> loadPuzzles(const std::string &filename, std::vector<ParseError> &errors,
+                                    bool useSimd = true) {
+    MappedFile file(filename);
+    std::vector<PackedGrid> grids;
+    // every line is at least 82 bytes, so this is an upper bound for a well-formed file
+    grids.reserve(file.size() / 82 + 1);
+    PuzzleParser(useSimd).parse(file.data(), file.size(), grids, errors);
+    return grids;
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <atomic>
+#include <chrono>
+
+// counters that are kept during a search
+struct SearchStats {
+    // number of values that were tried by branching (not the values found by propagation)
+    long long nodes = 0;
+    // number of tried values that turned out to be wrong and had to be undone
+    long long backtracks = 0;
+    // deepest level of branching that was reached, 0 if no branching was needed
+    int maxDepth = 0;
+    // number of values that were derived by propagation instead of branching
+    long long propagations = 0;
+    // wall time of the whole solve in seconds
+    double wallTime = 0;
+    // true if the search was stopped by its SearchLimits before it finished
+    bool aborted = false;
+};
+
+// a budget for a search, 0 means no limit
+struct SearchLimits {
+    long long maxNodes = 0;
+    double maxSeconds = 0;
+    // another thread can stop the search by setting this flag
+    const std::atomic<bool> *stop = nullptr;
+};
+
+// Keeps track of the limits while searching. A search calls exhausted after every node and stops (undoing
+// everything, as if the branch failed) as soon as it returns true. Reading the clock costs more than a node
+// of the bitmask solvers, so the time is only checked every 1024 calls.
+class SearchBudget {
+public:
+    explicit SearchBudget(const SearchLimits &limits = SearchLimits());
+
+    bool exhausted(SearchStats &stats);
+    // seconds since the budget was created
+    double elapsed() const;
+
+private:
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point start;
+    long long calls = 0;
+};
+
+SearchBudget::SearchBudget(const SearchLimits &limits) : limits(limits), start(std::chrono::steady_clock::now()) {
+}
+
+double SearchBudget::elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool SearchBudget::exhausted(SearchStats &stats) {
+    if (stats.aborted) {
+        return true;
+    }
+    if (limits.stop && limits.stop->load(std::memory_order_relaxed)) {
+        stats.aborted = true;
+    } else if (limits.maxNodes > 0 && stats.nodes >= limits.maxNodes) {
+        stats.aborted = true;
+    } else if (limits.maxSeconds > 0 && ++calls % 1024 == 0 && elapsed() > limits.maxSeconds) {
+        stats.aborted = true;
+    }
+    return stats.aborted;
+}
+
+#endif
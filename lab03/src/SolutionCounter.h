@@ -0,0 +1,160 @@
+#ifndef SOLUTIONCOUNTER_H
+#define SOLUTIONCOUNTER_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Sudoku.h"
+#include "PropagatingSolver.h"
+#include "ThreadPool.h"
+
+// The MRV + singles search of PropagatingSolver, but instead of stopping at the first solution it goes on
+// and counts every solution. Naked and hidden singles hold in every solution, so propagating doesn't lose
+// any. The count is shared between solvers, every solver stops as soon as cancel is set.
+class CountingSolver : public PropagatingSolver {
+public:
+    explicit CountingSolver(const Sudoku &s);
+
+    // propagate the givens, false if that already shows there is no solution
+    bool prepare();
+    // the cell to branch on, -1 if the grid is full (a solution)
+    int branchCell() const;
+    // count the solutions below the current grid; sets cancel when solutions reaches limit
+    void count(long long limit, std::atomic<long long> &solutions, std::atomic<bool> &cancel);
+};
+
+CountingSolver::CountingSolver(const Sudoku &s) : PropagatingSolver(s) {
+}
+
+bool CountingSolver::prepare() {
+    return consistent && propagate();
+}
+
+int CountingSolver::branchCell() const {
+    return mostConstrainedCell();
+}
+
+void CountingSolver::count(long long limit, std::atomic<long long> &solutions, std::atomic<bool> &cancel) {
+    if (cancel.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    int cell = mostConstrainedCell();
+    if (cell == -1) {
+        if (solutions.fetch_add(1) + 1 >= limit) {
+            cancel = true;
+        }
+        return;
+    }
+
+    int mark = trailSize;
+    for (uint16_t cand = candidates(cell); cand != 0; cand &= cand - 1) {
+        assignOnTrail(cell, __builtin_ctz(cand) + 1);
+        stats.nodes++;
+
+        if (propagate()) {
+            count(limit, solutions, cancel);
+        }
+
+        undoTrail(mark);
+        if (cancel.load(std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+enum class Uniqueness { noSolution, unique, multiple };
+
+// Counts the solutions of a sudoku on several cores, up to a limit.
+// The top of the search tree is expanded level by level (propagate, branch on the most constrained cell,
+// one child per candidate) until there are enough subtrees to keep every thread busy. Each subtree is then
+// counted as a task of a work-stealing pool. All tasks add to one atomic counter, and the one that reaches
+// the limit sets the cancel flag, which the other tasks check at every node, so they stop right away.
+// The sudoku itself is never changed.
+class SolutionCounter {
+public:
+    explicit SolutionCounter(int threadCount = std::thread::hardware_concurrency());
+
+    // the number of solutions, or limit if there are at least that many
+    long long count(const Sudoku &s, long long limit);
+    Uniqueness uniqueness(const Sudoku &s);
+
+    // the number of subtrees the last count was split in
+    int lastTaskCount() const { return taskCount; }
+
+private:
+    // stop expanding the tree at this depth or at this many subtrees per thread
+    static constexpr int MAX_SPLIT_DEPTH = 8;
+    static constexpr int SUBTREES_PER_THREAD = 8;
+
+    ThreadPool pool;
+    int taskCount = 0;
+};
+
+SolutionCounter::SolutionCounter(int threadCount) : pool(threadCount) {
+}
+
+long long SolutionCounter::count(const Sudoku &s, long long limit) {
+    // solutions found while expanding, the full grids in the frontier
+    long long direct = 0;
+    std::vector<Sudoku> frontier{s};
+
+    for (int depth = 0; depth < MAX_SPLIT_DEPTH && !frontier.empty()
+                        && frontier.size() < SUBTREES_PER_THREAD * pool.size(); depth++) {
+        std::vector<Sudoku> next;
+        for (const Sudoku &node : frontier) {
+            CountingSolver solver(node);
+            if (!solver.prepare()) {
+                continue;
+            }
+
+            int cell = solver.branchCell();
+            if (cell == -1) {
+                direct++;
+                continue;
+            }
+
+            Sudoku propagated;
+            solver.copyTo(propagated);
+            for (uint16_t cand = solver.candidates(cell); cand != 0; cand &= cand - 1) {
+                Sudoku child = propagated;
+                child.setCell(cell / 9, cell % 9, __builtin_ctz(cand) + 1);
+                next.push_back(child);
+            }
+        }
+        frontier.swap(next);
+
+        if (direct >= limit) {
+            taskCount = 0;
+            return limit;
+        }
+    }
+
+    std::atomic<long long> solutions{direct};
+    std::atomic<bool> cancel{false};
+    for (const Sudoku &node : frontier) {
+        pool.submit([&node, limit, &solutions, &cancel] {
+            if (cancel.load(std::memory_order_relaxed)) {
+                return;
+            }
+            CountingSolver solver(node);
+            if (solver.prepare()) {
+                solver.count(limit, solutions, cancel);
+            }
+        });
+    }
+    pool.wait();
+
+    taskCount = frontier.size();
+    return std::min(solutions.load(), limit);
+}
+
+Uniqueness SolutionCounter::uniqueness(const Sudoku &s) {
+    long long solutions = count(s, 2);
+    if (solutions == 0) {
+        return Uniqueness::noSolution;
+    }
+    return solutions == 1 ? Uniqueness::unique : Uniqueness::multiple;
+}
+
+#endif
@@ -3,6 +3,10 @@
 
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "SearchStats.h"
 
 // a coordinate represents a cell in a sudoku grid
 struct Coordinate_t {
@@ -12,7 +16,12 @@ typedef struct Coordinate_t Coordinate_t;
 
 class Sudoku{
 public:
+    // an empty grid
+    Sudoku();
+    // throws std::runtime_error if the file is missing or doesn't contain 81 values
     Sudoku(const std::string filename);
+    // read the next 81 values from a stream that can hold several sudokus after each other
+    explicit Sudoku(std::istream &in);
     bool isSolved() const;
     const Coordinate_t * findNextUnassignedCell() const;
     bool isValidInRow(int row, int value) const;
@@ -20,10 +29,17 @@ public:
     bool isValidInSubgrid(const Coordinate_t * cell, int value) const;
     bool isValid(const Coordinate_t * c, int value) const;
     bool solve();
+    // the same backtracking, but it fills in stats and stops (restoring the grid) when limits runs out
+    bool solve(SearchStats &stats, const SearchLimits &limits = SearchLimits());
     int sumOfThreeFirstCells() const;
+    // direct access to a cell, 0 means unassigned
+    int getCell(int row, int col) const;
+    void setCell(int row, int col, int value);
     friend std::ostream& operator<< (std::ostream &out, const Sudoku &s);
 private:
-    int grid[9][9];
+    bool search(SearchStats &stats, SearchBudget &budget, int depth);
+
+    int grid[9][9] = {};
 };
 
 std::ostream& operator<< (std::ostream &out, const Sudoku &s){
@@ -42,13 +58,28 @@ std::ostream& operator<< (std::ostream &out, const Sudoku &s){
     return out;
 }
 
+Sudoku::Sudoku(){
+}
+
 Sudoku::Sudoku(const std::string filename){
     std::ifstream infile(filename);
-    if (infile){
-        for (int i = 0; i < 9; i++){
-            for (int j = 0; j < 9; j++){
-                infile >> grid[i][j];
-            }
+    if (!infile){
+        throw std::runtime_error("cannot open " + filename);
+    }
+    for (int i = 0; i < 9; i++){
+        for (int j = 0; j < 9; j++){
+            infile >> grid[i][j];
+        }
+    }
+    if (!infile){
+        throw std::runtime_error(filename + " does not contain 81 values");
+    }
+}
+
+Sudoku::Sudoku(std::istream &in){
+    for (int i = 0; i < 9; i++){
+        for (int j = 0; j < 9; j++){
+            in >> grid[i][j];
         }
     }
 }
@@ -58,6 +89,14 @@ bool Sudoku::isSolved() const {
     // an array of type boolean keeps track of what value has been seen in a row, column or subgrid
     bool check[9]{false};
 
+    // every cell must hold a value in 1-9, an unassigned cell (0) would also index check[] out of bounds
+    for(int r = 0; r < 9; r++) {
+        for(int c = 0; c < 9; c++) {
+            if(grid[r][c] < 1 || grid[r][c] > 9)
+                return false;
+        }
+    }
+
     // check duplicates in rows
     for(int r = 0; r < 9; r++) {
         for(int c = 0; c < 9; c++) {
@@ -174,7 +213,8 @@ bool Sudoku::isValid(const Coordinate_t * coordinate, int value) const {
 }
 
 bool Sudoku::solve() {
-    const Coordinate_t * coordinate = findNextUnassignedCell();
+    // findNextUnassignedCell allocates the coordinate, make sure it gets freed on every return
+    std::unique_ptr<const Coordinate_t> coordinate(findNextUnassignedCell());
 
     // if no more unassigned cells then the sudoku is solved
     if(coordinate->row == -1 && coordinate->col == -1) {
@@ -184,7 +224,7 @@ bool Sudoku::solve() {
     // try every possible value (1-9)
     for(int value = 1; value <= 9; value++) {
         // check if the value is valid for the current cell, if not try the another value
-        if(!isValid(coordinate, value)) {
+        if(!isValid(coordinate.get(), value)) {
             continue;
         }
         
@@ -204,6 +244,53 @@ bool Sudoku::solve() {
     return false;
 }
 
+bool Sudoku::solve(SearchStats &stats, const SearchLimits &limits) {
+    SearchBudget budget(limits);
+    bool solved = search(stats, budget, 1);
+    stats.wallTime = budget.elapsed();
+    return solved;
+}
+
+// solve() with counters: every assigned value is a node, every undone value a backtrack
+bool Sudoku::search(SearchStats &stats, SearchBudget &budget, int depth) {
+    std::unique_ptr<const Coordinate_t> coordinate(findNextUnassignedCell());
+    if(coordinate->row == -1 && coordinate->col == -1) {
+        return true;
+    }
+    if(depth > stats.maxDepth) {
+        stats.maxDepth = depth;
+    }
+
+    for(int value = 1; value <= 9; value++) {
+        if(!isValid(coordinate.get(), value)) {
+            continue;
+        }
+
+        grid[coordinate->row][coordinate->col] = value;
+        stats.nodes++;
+
+        if(search(stats, budget, depth + 1)) {
+            return true;
+        }
+
+        grid[coordinate->row][coordinate->col] = 0;
+        stats.backtracks++;
+        if(budget.exhausted(stats)) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+int Sudoku::getCell(int row, int col) const {
+    return grid[row][col];
+}
+
+void Sudoku::setCell(int row, int col, int value) {
+    grid[row][col] = value;
+}
+
 // return the value for the 3-digit number in the upper left corner if the sudoku is solved, otherwise return -1
 int Sudoku::sumOfThreeFirstCells() const {
     if(isSolved()) {
@@ -0,0 +1,134 @@
+#ifndef VALIDATOR_H
+#define VALIDATOR_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "PackedGrid.h"
+
+// Checks whether a packed grid is a solved sudoku without looping over the 27 groups one by one.
+//
+// First every cell is checked to hold a value in 1-9, with SSE2 that is a subtract and a saturating compare
+// per 16 cells. Grids with an empty or out of range cell are rejected there, before any board is built.
+//
+// Then for every digit d a board is built with a bit for every cell that holds d, one compare and one
+// movemask per 16 cells. The grid is solved if every board has a bit in every row, every column and every
+// subgrid: then every digit occurs at least 9 times, and since there are only 81 cells, exactly 9 times,
+// once in every group. A digit that misses a group occurs twice in another one, so the check stops at the
+// first digit that fails.
+//
+// A board is split in its 3 bands of 27 bits (3 rows of 9 bits), so it fits in 32-bit words. The groups are
+// checked with shifts and ORs:
+// - rows: fold the 9 bits of every row onto its first bit, bits 0, 9 and 18 must be set
+// - subgrids: fold the 3 rows onto the first row, then every 3 bits onto their first bit, bits 0, 3 and 6
+//   must be set
+// - columns: the OR of the 3 folded bands must have all 9 bits set
+class Validator {
+public:
+    static bool isSolved(const PackedGrid &grid);
+    // validate many grids one after the other, result[i] is 1 if grids[i] is solved
+    static std::vector<uint8_t> isSolved(const std::vector<PackedGrid> &grids);
+
+private:
+    static constexpr uint32_t BAND = (1u << 27) - 1;
+    static constexpr uint32_t FIRST_OF_ROWS = 1 | 1 << 9 | 1 << 18;
+    static constexpr uint32_t FIRST_OF_BOXES = 1 | 1 << 3 | 1 << 6;
+    static constexpr uint32_t ROW = 0x1FF;
+
+    // bands[d][k] holds the cells of band k with digit d + 1, false if a cell is not in 1-9
+    static bool digitBands(const PackedGrid &grid, uint32_t bands[9][3]);
+};
+
+bool Validator::digitBands(const PackedGrid &grid, uint32_t bands[9][3]) {
+#ifdef __SSE2__
+    // 6 vectors of 16 cells, the 15 bytes after the last cell are 1 so they pass the range check, their bits
+    // end up above the last band and are masked off
+    alignas(16) uint8_t padded[96];
+    memcpy(padded, grid.cells, 81);
+    memset(padded + 81, 1, 15);
+
+    // value - 1 wraps 0 to 255, so a cell is in 1-9 if value - 1 saturated minus 8 is 0
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i eight = _mm_set1_epi8(8);
+    __m128i cells[6];
+    __m128i outOfRange = _mm_setzero_si128();
+    for (int i = 0; i < 6; i++) {
+        cells[i] = _mm_load_si128(reinterpret_cast<const __m128i *>(padded + 16 * i));
+        outOfRange = _mm_or_si128(outOfRange, _mm_subs_epu8(_mm_sub_epi8(cells[i], one), eight));
+    }
+    const int rangeMask = _mm_movemask_epi8(_mm_cmpeq_epi8(outOfRange, _mm_setzero_si128()));
+    if (rangeMask != 0xFFFF) {
+        return false;
+    }
+
+    for (int d = 0; d < 9; d++) {
+        const __m128i digit = _mm_set1_epi8(d + 1);
+        uint64_t masks[6];
+        for (int i = 0; i < 6; i++) {
+            masks[i] = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(cells[i], digit)));
+        }
+        // cells 0-63 and 64-80
+        uint64_t low = masks[0] | masks[1] << 16 | masks[2] << 32 | masks[3] << 48;
+        uint64_t high = masks[4] | masks[5] << 16;
+
+        bands[d][0] = low & BAND;
+        bands[d][1] = (low >> 27) & BAND;
+        bands[d][2] = ((low >> 54) | (high << 10)) & BAND;
+    }
+#else
+    for (int d = 0; d < 9; d++) {
+        bands[d][0] = bands[d][1] = bands[d][2] = 0;
+    }
+    for (int cell = 0; cell < 81; cell++) {
+        int value = grid.cells[cell];
+        if (value >= 1 && value <= 9) {
+            bands[value - 1][cell / 27] |= 1u << (cell % 27);
+        } else {
+            return false;
+        }
+    }
+#endif
+    return true;
+}
+
+bool Validator::isSolved(const PackedGrid &grid) {
+    uint32_t bands[9][3];
+    if (!digitBands(grid, bands)) {
+        return false;
+    }
+
+    for (int d = 0; d < 9; d++) {
+        uint32_t rows = FIRST_OF_ROWS;
+        uint32_t boxes = FIRST_OF_BOXES;
+        uint32_t columns = 0;
+        for (int k = 0; k < 3; k++) {
+            const uint32_t b = bands[d][k];
+
+            uint32_t r = b | (b >> 1) | (b >> 2);
+            rows &= r | (r >> 3) | (r >> 6);
+
+            uint32_t folded = b | (b >> 9) | (b >> 18);
+            boxes &= folded | (folded >> 1) | (folded >> 2);
+            columns |= folded;
+        }
+        if (rows != FIRST_OF_ROWS || boxes != FIRST_OF_BOXES || (columns & ROW) != ROW) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> Validator::isSolved(const std::vector<PackedGrid> &grids) {
+    std::vector<uint8_t> result(grids.size());
+    for (size_t i = 0; i < grids.size(); i++) {
+        result[i] = isSolved(grids[i]);
+    }
+    return result;
+}
+
+#endif
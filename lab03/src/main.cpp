@@ -1,26 +1,581 @@
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <vector>
 #include "Sudoku.h"
+#include "BitmaskSolver.h"
+#include "PropagatingSolver.h"
+#include "DancingLinks.h"
+#include "BatchSolver.h"
+#include "PuzzleLoader.h"
+#include "Validator.h"
+#include "GeneralSudoku.h"
+#include "PuzzleGenerator.h"
+#include "CdclSolver.h"
+#include "Portfolio.h"
+#include "SolutionCounter.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+// solve sudokus/1.txt to 50.txt with the backtracker. With a report name, the search statistics of every
+// sudoku are written to <report>.csv and <report>.json as well.
+void solveAll(const std::string &report = "", const SearchLimits &limits = SearchLimits()) {
+    std::ofstream csv, json;
+    if(!report.empty()) {
+        csv.open(report + ".csv");
+        json.open(report + ".json");
+        csv << "sudoku,solved,aborted,nodes,backtracks,max_depth,propagations,wall_time_us,first_three" << std::endl;
+        json << "[" << std::endl;
+    }
 
-void solveAll() {
     int sum = 0;
+    bool failed = false;
     for(int i = 1; i <= 50; i++) {
         Sudoku s("./sudokus/" + std::to_string(i) + ".txt");
-        s.solve();
-        
-        sum += s.sumOfThreeFirstCells();
-        if(sum == -1) {
-            break;
+        SearchStats stats;
+        bool solved = s.solve(stats, limits);
+
+        int firstThree = s.sumOfThreeFirstCells();
+        if(firstThree == -1) {
+            failed = true;
+        } else {
+            sum += firstThree;
+        }
+
+        if(!report.empty()) {
+            long long wallTime = stats.wallTime * 1e6;
+            csv << i << "," << solved << "," << stats.aborted << "," << stats.nodes << "," << stats.backtracks << ","
+                << stats.maxDepth << "," << stats.propagations << "," << wallTime << "," << firstThree << std::endl;
+            json << (i > 1 ? ",\n" : "") << "  {\"sudoku\": " << i << ", \"solved\": " << (solved ? "true" : "false")
+                 << ", \"aborted\": " << (stats.aborted ? "true" : "false") << ", \"nodes\": " << stats.nodes
+                 << ", \"backtracks\": " << stats.backtracks << ", \"max_depth\": " << stats.maxDepth
+                 << ", \"propagations\": " << stats.propagations << ", \"wall_time_us\": " << wallTime
+                 << ", \"first_three\": " << firstThree << "}";
         }
     }
 
-    if(sum == -1) {
+    if(!report.empty()) {
+        json << std::endl << "]" << std::endl;
+        std::cout << "statistics per sudoku written to " << report << ".csv and " << report << ".json" << std::endl;
+    }
+
+    if(failed) {
         std::cout << "something went wrong when solving all sudokus" << std::endl;
     } else {
         std::cout << "the sum of all 3-digit numbers in the upper left corner of each sudoku: " << sum << std::endl;
     }
 }
 
+// stop the solvers on the hardest of the 50 sudokus with a node budget and with a time budget
+void demonstrateLimits() {
+    Sudoku hardest("./sudokus/13.txt");
+    const SearchLimits budgets[] = {{10000, 0}, {0, 0.001}};
+
+    for(const SearchLimits &limits : budgets) {
+        Sudoku s = hardest;
+        SearchStats stats;
+        s.solve(stats, limits);
+
+        BitmaskSolver bitmask(hardest);
+        bitmask.solve(limits);
+
+        bool restored = true;
+        for(int cell = 0; cell < 81; cell++) {
+            restored = restored && s.getCell(cell / 9, cell % 9) == hardest.getCell(cell / 9, cell % 9);
+        }
+
+        std::cout << "budget of " << (limits.maxNodes > 0 ? std::to_string(limits.maxNodes) + " nodes"
+                                                           : std::to_string(int(limits.maxSeconds * 1000)) + " ms") << ": "
+                  << "backtracking " << (stats.aborted ? "aborted" : "finished") << " after " << stats.nodes
+                  << " nodes (max depth " << stats.maxDepth << "), bitmask "
+                  << (bitmask.getStats().aborted ? "aborted" : "finished") << " after " << bitmask.getStats().nodes
+                  << " nodes, grid restored: " << (restored ? "yes" : "no")
+                  << std::endl;
+    }
+}
+
+std::vector<Sudoku> loadAll() {
+    std::vector<Sudoku> sudokus;
+    for(int i = 1; i <= 50; i++) {
+        sudokus.push_back(Sudoku("./sudokus/" + std::to_string(i) + ".txt"));
+    }
+    return sudokus;
+}
+
+// solve all sudokus with the given solver and print the time it took, loading happens before the timing starts
+template <typename Solve>
+void benchmark(const std::string &name, std::vector<Sudoku> sudokus, Solve solve) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    int sum = 0;
+    for(Sudoku &s : sudokus) {
+        solve(s);
+        sum += s.sumOfThreeFirstCells();
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << name << ": " << duration.count() << " us (sum " << sum << ")" << std::endl;
+}
+
+void benchmarkSolvers() {
+    std::vector<Sudoku> sudokus = loadAll();
+
+    benchmark("backtracking", sudokus, [](Sudoku &s) { s.solve(); });
+    benchmark("bitmask backtracking", sudokus, [](Sudoku &s) {
+        BitmaskSolver solver(s);
+        if(solver.solve()) {
+            solver.copyTo(s);
+        }
+    });
+    benchmark("MRV + singles", sudokus, [](Sudoku &s) {
+        PropagatingSolver solver(s);
+        if(solver.solve()) {
+            solver.copyTo(s);
+        }
+    });
+    benchmark("dancing links", sudokus, [](Sudoku &s) {
+        DlxSolver solver(s);
+        if(solver.solve()) {
+            solver.copyTo(s);
+        }
+    });
+}
+
+// time in microseconds to solve a copy of the sudoku
+template <typename Solve>
+long long timeSolve(Sudoku s, Solve solve) {
+    auto start = std::chrono::high_resolution_clock::now();
+    solve(s);
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+}
+
+// compare the solvers on the sudokus where the naive backtracker needs the most time,
+// and use dancing links to check how many solutions each sudoku has
+void benchmarkWorstCases() {
+    std::vector<std::pair<std::string, Sudoku>> sudokus;
+    for(int i = 1; i <= 50; i++) {
+        sudokus.emplace_back(std::to_string(i), Sudoku("./sudokus/" + std::to_string(i) + ".txt"));
+    }
+    sudokus.emplace_back("diagonal", Sudoku("./diagonal.txt"));
+    sudokus.emplace_back("zeros", Sudoku("./zeros.txt"));
+
+    std::vector<std::pair<long long, int>> naiveTimes;
+    for(int i = 0; i < sudokus.size(); i++) {
+        naiveTimes.emplace_back(timeSolve(sudokus[i].second, [](Sudoku &s) { s.solve(); }), i);
+    }
+    std::sort(naiveTimes.rbegin(), naiveTimes.rend());
+
+    const int worstCount = 5;
+    std::cout << std::setw(10) << "sudoku" << std::setw(16) << "backtracking" << std::setw(12) << "bitmask"
+              << std::setw(16) << "MRV + singles" << std::setw(16) << "dancing links" << std::setw(12) << "solutions"
+              << "   (times in us)" << std::endl;
+
+    for(int w = 0; w < worstCount && w < naiveTimes.size(); w++) {
+        const auto &entry = sudokus[naiveTimes[w].second];
+        DlxSolver counter(entry.second);
+
+        std::cout << std::setw(10) << entry.first << std::setw(16) << naiveTimes[w].first
+                  << std::setw(12) << timeSolve(entry.second, [](Sudoku &s) { BitmaskSolver(s).solve(); })
+                  << std::setw(16) << timeSolve(entry.second, [](Sudoku &s) { PropagatingSolver(s).solve(); })
+                  << std::setw(16) << timeSolve(entry.second, [](Sudoku &s) { DlxSolver(s).solve(); })
+                  << std::setw(11) << counter.countSolutions(2) << (counter.countSolutions(2) > 1 ? "+" : " ")
+                  << std::endl;
+    }
+
+    int unique = 0;
+    for(const auto &entry : sudokus) {
+        if(DlxSolver(entry.second).countSolutions(2) == 1) {
+            unique++;
+        }
+    }
+    std::cout << unique << " of " << sudokus.size() << " sudokus have exactly one solution" << std::endl;
+}
+
+// print for each sudoku how many nodes and backtracks each search needed
+void printSearchStats() {
+    std::vector<Sudoku> sudokus = loadAll();
+
+    std::cout << std::setw(8) << "sudoku" << std::setw(22) << "backtracking nodes" << std::setw(12) << "backtracks"
+              << std::setw(22) << "MRV + singles nodes" << std::setw(12) << "backtracks" << std::endl;
+
+    SearchStats totalBitmask, totalPropagating;
+    for(int i = 0; i < sudokus.size(); i++) {
+        BitmaskSolver bitmask(sudokus[i]);
+        bitmask.solve();
+        PropagatingSolver propagating(sudokus[i]);
+        propagating.solve();
+
+        const SearchStats &b = bitmask.getStats();
+        const SearchStats &p = propagating.getStats();
+        std::cout << std::setw(8) << i + 1 << std::setw(22) << b.nodes << std::setw(12) << b.backtracks
+                  << std::setw(22) << p.nodes << std::setw(12) << p.backtracks << std::endl;
+
+        totalBitmask.nodes += b.nodes;
+        totalBitmask.backtracks += b.backtracks;
+        totalPropagating.nodes += p.nodes;
+        totalPropagating.backtracks += p.backtracks;
+    }
+
+    std::cout << std::setw(8) << "total" << std::setw(22) << totalBitmask.nodes << std::setw(12) << totalBitmask.backtracks
+              << std::setw(22) << totalPropagating.nodes << std::setw(12) << totalPropagating.backtracks << std::endl;
+}
+
+// solve the sudokus in batch on a thread pool: once from the 50 files, and once from one concatenated stream
+// with every sudoku repeated, for an increasing number of threads. The sum must be the same for every run.
+void benchmarkBatch() {
+    std::vector<std::string> filenames;
+    for(int i = 1; i <= 50; i++) {
+        filenames.push_back("./sudokus/" + std::to_string(i) + ".txt");
+    }
+    PuzzleStream files(filenames);
+    BatchResult fromFiles = BatchSolver<>().solve(files);
+    std::cout << "from " << filenames.size() << " files: " << fromFiles.solved << " of " << fromFiles.puzzles
+              << " solved, sum " << fromFiles.sum << std::endl;
+
+    const int repeats = 400;
+    std::stringstream concatenated;
+    for(const Sudoku &s : loadAll()) {
+        for(int cell = 0; cell < 81; cell++) {
+            concatenated << s.getCell(cell / 9, cell % 9) << (cell % 9 == 8 ? '\n' : ' ');
+        }
+    }
+    const std::string once = concatenated.str();
+    std::string all;
+    for(int r = 0; r < repeats; r++) {
+        all += once;
+    }
+
+    std::cout << std::setw(10) << "threads" << std::setw(12) << "puzzles" << std::setw(14) << "puzzles/s"
+              << std::setw(12) << "speedup" << std::setw(12) << "sum" << std::endl;
+
+    const int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    double single = 0;
+    for(int threads = 1; ; threads = std::min(2 * threads, maxThreads)) {
+        std::istringstream in(all);
+        PuzzleStream stream(in);
+        BatchResult result = BatchSolver<>(threads).solve(stream);
+        if(threads == 1) {
+            single = result.puzzlesPerSecond();
+        }
+
+        std::cout << std::setw(10) << threads << std::setw(12) << result.puzzles << std::setw(14)
+                  << std::fixed << std::setprecision(0) << result.puzzlesPerSecond() << std::setw(12)
+                  << std::setprecision(2) << result.puzzlesPerSecond() / single << std::setw(12) << result.sum
+                  << std::defaultfloat << std::endl;
+
+        if(threads == maxThreads) {
+            break;
+        }
+    }
+}
+
+// time loading a file with many sudokus: in the line format with the vectorized and the scalar parser, and
+// in the format of sudokus/1.txt (81 whitespace separated values) with operator>>
+void benchmarkLoading() {
+    const int repeats = 2000;
+    const std::string lineFile = "./benchmark_lines.txt";
+    const std::string valuesFile = "./benchmark_values.txt";
+    {
+        std::ofstream lines(lineFile);
+        std::ofstream values(valuesFile);
+        std::vector<Sudoku> sudokus = loadAll();
+        for(int r = 0; r < repeats; r++) {
+            for(const Sudoku &s : sudokus) {
+                for(int cell = 0; cell < 81; cell++) {
+                    int value = s.getCell(cell / 9, cell % 9);
+                    lines << (value == 0 ? '.' : char('0' + value));
+                    values << value << (cell % 9 == 8 ? '\n' : ' ');
+                }
+                lines << '\n';
+            }
+        }
+    }
+
+    auto report = [](const std::string &name, long long puzzles, long long sum,
+                     std::chrono::high_resolution_clock::time_point start) {
+        auto stop = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(stop - start).count();
+        std::cout << std::setw(24) << name << std::setw(10) << puzzles << " puzzles" << std::setw(14) << std::fixed
+                  << std::setprecision(0) << puzzles / seconds << " puzzles/s  (checksum " << sum << ")"
+                  << std::defaultfloat << std::endl;
+    };
+
+    for(bool simd : {true, false}) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<ParseError> errors;
+        std::vector<PackedGrid> grids = loadPuzzles(lineFile, errors, simd);
+        long long sum = 0;
+        for(const PackedGrid &g : grids) {
+            sum += g.cells[2];
+        }
+        report(simd ? "lines, SSE2 parser" : "lines, scalar parser", grids.size(), sum, start);
+    }
+
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::ifstream in(valuesFile);
+        std::vector<Sudoku> sudokus;
+        PuzzleStream stream(in);
+        while(stream.read(sudokus, 1024) > 0) {
+        }
+        long long sum = 0;
+        for(const Sudoku &s : sudokus) {
+            sum += s.getCell(0, 2);
+        }
+        report("values, operator>>", sudokus.size(), sum, start);
+    }
+
+    std::remove(lineFile.c_str());
+    std::remove(valuesFile.c_str());
+
+    // errors are reported with their line number, the valid lines are still loaded
+    const std::string broken = "# two good lines and two broken ones\n"
+        "003020600900305001001806400008102900700000008006708200002609500800203009005010300\n"
+        "00302060090030500100180640000810290070000000800670820000260950080020300900501030\n"
+        "..3.2.6..9..3.5..1..18.64....81.29..7.......8..67.82....26.95..8..2.3..9..5.x.3..\r\n"
+        "..3.2.6..9..3.5..1..18.64....81.29..7.......8..67.82....26.95..8..2.3..9..5.1.3..";
+    std::vector<PackedGrid> grids;
+    std::vector<ParseError> errors;
+    PuzzleParser().parse(broken.data(), broken.size(), grids, errors);
+    std::cout << grids.size() << " sudokus loaded from a broken file, errors:" << std::endl;
+    for(const ParseError &e : errors) {
+        std::cout << "  line " << e.line << ": " << e.message << std::endl;
+    }
+}
+
+// check many grids with Sudoku::isSolved and with the vectorized Validator: the solutions of the 50 sudokus,
+// and for each of them a copy with two swapped cells, an empty cell and a value out of range
+void benchmarkValidation() {
+    std::vector<PackedGrid> grids;
+    for(Sudoku &s : loadAll()) {
+        PropagatingSolver solver(s);
+        solver.solve();
+        solver.copyTo(s);
+
+        PackedGrid solved = PackedGrid::fromSudoku(s);
+        grids.push_back(solved);
+
+        PackedGrid swapped = solved;
+        std::swap(swapped.cells[10], swapped.cells[11]);
+        grids.push_back(swapped);
+
+        PackedGrid empty = solved;
+        empty.cells[40] = 0;
+        grids.push_back(empty);
+
+        PackedGrid outOfRange = solved;
+        outOfRange.cells[80] = 10;
+        grids.push_back(outOfRange);
+    }
+
+    const int repeats = 1000;
+    std::vector<PackedGrid> all;
+    for(int r = 0; r < repeats; r++) {
+        all.insert(all.end(), grids.begin(), grids.end());
+    }
+    std::vector<Sudoku> sudokus;
+    for(const PackedGrid &g : all) {
+        sudokus.push_back(g.toSudoku());
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    long long solvedScalar = 0;
+    for(const Sudoku &s : sudokus) {
+        solvedScalar += s.isSolved();
+    }
+    auto middle = std::chrono::high_resolution_clock::now();
+    std::vector<uint8_t> results = Validator::isSolved(all);
+    long long solvedSimd = std::count(results.begin(), results.end(), 1);
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    double scalarSeconds = std::chrono::duration<double>(middle - start).count();
+    double simdSeconds = std::chrono::duration<double>(stop - middle).count();
+    std::cout << std::fixed << std::setprecision(0)
+              << "Sudoku::isSolved: " << all.size() / scalarSeconds << " grids/s, " << solvedScalar << " of "
+              << all.size() << " solved" << std::endl
+              << "Validator:        " << all.size() / simdSeconds << " grids/s, " << solvedSimd << " of "
+              << all.size() << " solved" << std::defaultfloat << std::endl;
+}
+
+// solve generated sudokus of one size with the MRV + singles solver for that size
+template <int N>
+void benchmarkSize(double givens, int count) {
+    auto start = std::chrono::high_resolution_clock::now();
+    int solved = 0;
+    SearchStats total;
+    for(int i = 0; i < count; i++) {
+        GeneralSudoku<N> s = GeneralSudoku<N>::generate(i, givens);
+        BasicPropagatingSolver<N> solver(s);
+        if(solver.solve()) {
+            solver.copyTo(s);
+            solved += s.isSolved();
+        }
+        total.nodes += solver.getStats().nodes;
+        total.backtracks += solver.getStats().backtracks;
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    const std::string size = std::to_string(N * N) + "x" + std::to_string(N * N);
+    const std::string solvedOfCount = std::to_string(solved) + "/" + std::to_string(count);
+    std::cout << std::setw(13) << size << std::setw(8) << std::setprecision(2) << givens << std::setw(17)
+              << solvedOfCount << std::setw(10) << total.nodes << std::setw(12) << total.backtracks << std::setw(12)
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / count << std::endl;
+}
+
+// solve 16x16 and 25x25 sudokus: the one in 16x16.txt, and a suite of generated ones with a fixed seed per puzzle
+void benchmarkLargeSudokus() {
+    if(boxSizeOf("./16x16.txt") == 4) {
+        GeneralSudoku<4> s("./16x16.txt");
+        BasicPropagatingSolver<4> solver(s);
+        solver.solve();
+        solver.copyTo(s);
+        std::cout << "16x16.txt " << (s.isSolved() ? "solved" : "not solved") << " with "
+                  << solver.getStats().nodes << " nodes:" << std::endl << s << std::endl;
+    }
+
+    std::cout << std::setw(13) << "size" << std::setw(8) << "givens" << std::setw(17) << "solved"
+              << std::setw(10) << "nodes" << std::setw(12) << "backtracks" << std::setw(12) << "us/sudoku" << std::endl;
+    benchmarkSize<3>(0.35, 200);
+    benchmarkSize<4>(0.5, 100);
+    benchmarkSize<4>(0.45, 100);
+    benchmarkSize<5>(0.6, 50);
+    benchmarkSize<5>(0.55, 50);
+}
+
+// average time in microseconds for a solver over a set of puzzles
+template <typename Solver>
+long long averageSolveTime(const std::vector<PackedGrid> &puzzles) {
+    long long total = 0;
+    for(const PackedGrid &p : puzzles) {
+        total += timeSolve(p.toSudoku(), [](Sudoku &s) { Solver(s).solve(); });
+    }
+    return puzzles.empty() ? 0 : total / (long long) puzzles.size();
+}
+
+// generate a seeded corpus of sudokus with a unique solution, write each difficulty to generated_<difficulty>.txt
+// in the line format and compare the solvers per difficulty
+void benchmarkGenerated() {
+    const uint64_t seed = 2024;
+    const int perDifficulty = 20;
+    const std::string names[] = {"easy", "hard", "pathological"};
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::vector<PackedGrid>> buckets = PuzzleGenerator(seed).generateBuckets(perDifficulty, 2000);
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "generated with seed " << seed << " in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count() << " ms" << std::endl;
+
+    // the difficulty is the work of MRV + singles, so its solve times should go up with it, the other solvers
+    // don't have to follow (see DifficultyRater)
+    std::cout << std::setw(14) << "difficulty" << std::setw(10) << "puzzles" << std::setw(8) << "work"
+              << std::setw(16) << "MRV + singles" << std::setw(12) << "bitmask" << std::setw(16) << "dancing links"
+              << "   (average us)" << std::endl;
+    long long previous = -1;
+    bool ordered = true;
+    for(int d = 0; d < 3; d++) {
+        const std::string filename = "./generated_" + names[d] + ".txt";
+        writePuzzles(filename, buckets[d]);
+
+        std::vector<ParseError> errors;
+        std::vector<PackedGrid> puzzles = loadPuzzles(filename, errors);
+
+        long long work = 0;
+        for(const PackedGrid &p : puzzles) {
+            work += PuzzleGenerator::rate(p).work;
+        }
+        long long reference = averageSolveTime<PropagatingSolver>(puzzles);
+        ordered = ordered && reference >= previous;
+        previous = reference;
+
+        std::cout << std::setw(14) << names[d] << std::setw(10) << puzzles.size()
+                  << std::setw(8) << (puzzles.empty() ? 0 : work / (long long) puzzles.size())
+                  << std::setw(16) << reference
+                  << std::setw(12) << averageSolveTime<BitmaskSolver>(puzzles)
+                  << std::setw(16) << averageSolveTime<DlxSolver>(puzzles) << std::endl;
+    }
+    std::cout << "MRV + singles times " << (ordered ? "follow" : "do NOT follow") << " the difficulty" << std::endl;
+}
+
+// compare the CDCL solver with the backtracker on puzzles that are hard for a fixed branching order, and let
+// the portfolio race both
+void benchmarkAdversarial() {
+    const std::string files[] = {"./anti_backtracking.txt", "./zeros.txt", "./diagonal.txt", "./sudokus/13.txt"};
+    const SearchLimits limits{0, 5.0};
+
+    std::cout << std::setw(26) << "sudoku" << std::setw(16) << "backtracking" << std::setw(10) << "CDCL"
+              << std::setw(11) << "decisions" << std::setw(11) << "conflicts" << std::setw(14) << "portfolio"
+              << std::setw(14) << "winner" << "   (times in us)" << std::endl;
+
+    for(const std::string &file : files) {
+        Sudoku s(file);
+
+        Sudoku backtracked = s;
+        SearchStats stats;
+        backtracked.solve(stats, limits);
+
+        CdclSolver cdcl(s);
+        long long cdclTime = timeSolve(s, [](Sudoku &t) { CdclSolver(t).solve(); });
+        cdcl.solve();
+
+        Sudoku raced = s;
+        PortfolioResult result;
+        long long portfolioTime = timeSolve(s, [&](Sudoku &t) { result = solvePortfolio(t, limits); raced = t; });
+
+        std::string backtrackTime = stats.aborted ? "> " + std::to_string((int) limits.maxSeconds) + " s"
+                                                  : std::to_string((long long) (stats.wallTime * 1e6));
+        std::cout << std::setw(26) << file << std::setw(16) << backtrackTime << std::setw(10) << cdclTime
+                  << std::setw(11) << cdcl.getStats().nodes << std::setw(11) << cdcl.getStats().backtracks
+                  << std::setw(14) << portfolioTime << std::setw(14) << result.winner
+                  << (raced.isSolved() ? "" : "   (not solved)") << std::endl;
+    }
+}
+
+// count solutions up to a limit on 1 thread and on every core; the counter stops all threads at the limit
+void benchmarkCounting() {
+    Sudoku fewerGivens("./sudokus/1.txt");
+    for(int removed = 0, cell = 0; removed < 8; cell++) {
+        if(fewerGivens.getCell(cell / 9, cell % 9) != 0) {
+            fewerGivens.setCell(cell / 9, cell % 9, 0);
+            removed++;
+        }
+    }
+
+    const std::pair<std::string, Sudoku> sudokus[] = {
+        {"sudokus/1.txt", Sudoku("./sudokus/1.txt")},
+        {"1.txt - 8 givens", fewerGivens},
+        {"diagonal.txt", Sudoku("./diagonal.txt")},
+        {"zeros.txt", Sudoku("./zeros.txt")},
+        {"invalid.txt", Sudoku("./invalid.txt")},
+    };
+    const long long limit = 100000;
+    const int cores = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << std::setw(20) << "sudoku" << std::setw(10) << "threads" << std::setw(10) << "subtrees"
+              << std::setw(12) << "solutions" << std::setw(12) << "time (ms)" << "   (limit " << limit << ")" << std::endl;
+    for(const auto &entry : sudokus) {
+        for(int threads : {1, cores}) {
+            SolutionCounter counter(threads);
+            auto start = std::chrono::high_resolution_clock::now();
+            long long solutions = counter.count(entry.second, limit);
+            auto stop = std::chrono::high_resolution_clock::now();
+
+            std::cout << std::setw(20) << entry.first << std::setw(10) << threads << std::setw(10)
+                      << counter.lastTaskCount() << std::setw(11) << solutions << (solutions == limit ? "+" : " ")
+                      << std::setw(12) << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count()
+                      << std::endl;
+            if(cores == 1) {
+                break;
+            }
+        }
+    }
+}
+
 /**
  * backtracking algorithm to solve a sudoku:
  * The algorithm first looks for an unassigned cell, if there is one. If found it will try every possible value (1-9) for a cell. 
@@ -54,5 +609,36 @@ int main() {
     }
 
     std::cout << "solving all sudokus:" << std::endl;
-    solveAll();
+    solveAll("solve_report", SearchLimits{0, 10.0});
+    demonstrateLimits();
+
+    std::cout << std::endl << "solving all sudokus with each solver:" << std::endl;
+    benchmarkSolvers();
+
+    std::cout << std::endl << "search statistics per sudoku:" << std::endl;
+    printSearchStats();
+
+    std::cout << std::endl << "worst cases for the backtracker:" << std::endl;
+    benchmarkWorstCases();
+
+    std::cout << std::endl << "solving in batch:" << std::endl;
+    benchmarkBatch();
+
+    std::cout << std::endl << "loading sudokus:" << std::endl;
+    benchmarkLoading();
+
+    std::cout << std::endl << "validating solutions:" << std::endl;
+    benchmarkValidation();
+
+    std::cout << std::endl << "larger sudokus:" << std::endl;
+    benchmarkLargeSudokus();
+
+    std::cout << std::endl << "generated sudokus:" << std::endl;
+    benchmarkGenerated();
+
+    std::cout << std::endl << "adversarial sudokus:" << std::endl;
+    benchmarkAdversarial();
+
+    std::cout << std::endl << "counting solutions:" << std::endl;
+    benchmarkCounting();
 }
@@ -0,0 +1,175 @@
+#ifndef ALLPAIRS_H
+#define ALLPAIRS_H
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "documents.h"
+#include "threadpool.h"
+
+/*
+Computes similarity(i, o) for every pair of documents i < o on a thread pool and keeps, for every document i,
+the k most similar documents o > i (the same pairs that jaccard puts in similarities[i]).
+
+The documents are divided into blocks of about TILE_TOKENS tokens, so that the tokens of two blocks fit in the
+L2 cache together. Every tile (block a, block b) with a <= b of the upper triangle is one task. A task adds its
+pairs to the top-k heaps of the thread that runs it, so no locks are needed; at the end the heaps of all threads
+are merged per document. The result does not depend on the number of threads: (similarity, document) pairs are
+totally ordered, so the k largest are always the same.
+The heaps take threads * documents * k pairs of memory.
+*/
+class AllPairs
+{
+public:
+    typedef std::pair<double, int> Similar;
+
+    static constexpr size_t TILE_TOKENS = 16 * 1024;
+
+    AllPairs(ThreadPool &pool, int k) : pool(pool), k(k) {}
+
+    template <typename Similarity>
+    std::vector<std::priority_queue<Similar>> run(const Documents &documents, Similarity similarity);
+    // for "count" documents of the same size, such as MinHash signatures
+    template <typename Similarity>
+    std::vector<std::priority_queue<Similar>> run(size_t count, size_t tokens, Similarity similarity);
+
+    // number of tiles of the last run
+    size_t tileCount() const { return tiles; }
+
+private:
+    // min-heaps of at most k pairs: the least similar of the k is in front and is the one to be replaced
+    struct TopK
+    {
+        std::vector<Similar> heap;
+        std::vector<int> count;
+
+        void push(int document, int k, const Similar &s);
+    };
+
+    std::vector<size_t> blocks(const Documents &documents) const;
+    template <typename Similarity>
+    std::vector<std::priority_queue<Similar>> runTiles(const std::vector<size_t> &starts, Similarity similarity);
+
+    ThreadPool &pool;
+    int k;
+    size_t tiles = 0;
+};
+
+void AllPairs::TopK::push(int document, int k, const Similar &s)
+{
+    Similar *first = heap.data() + (size_t)document * k;
+    int &n = count[document];
+
+    if (n < k)
+    {
+        first[n++] = s;
+        std::push_heap(first, first + n, std::greater<Similar>());
+    }
+    else if (first[0] < s)
+    {
+        std::pop_heap(first, first + k, std::greater<Similar>());
+        first[k - 1] = s;
+        std::push_heap(first, first + k, std::greater<Similar>());
+    }
+}
+
+// the first document of every block, followed by the number of documents
+std::vector<size_t> AllPairs::blocks(const Documents &documents) const
+{
+    std::vector<size_t> starts(1, 0);
+    size_t tokens = 0;
+    for (size_t i = 0; i < documents.size(); i++)
+    {
+        if (tokens > 0 && tokens + documents.size(i) > TILE_TOKENS)
+        {
+            starts.push_back(i);
+            tokens = 0;
+        }
+        tokens += documents.size(i);
+    }
+    starts.push_back(documents.size());
+    return starts;
+}
+
+template <typename Similarity>
+std::vector<std::priority_queue<AllPairs::Similar>> AllPairs::run(const Documents &documents, Similarity similarity)
+{
+    return runTiles(blocks(documents), similarity);
+}
+
+template <typename Similarity>
+std::vector<std::priority_queue<AllPairs::Similar>> AllPairs::run(size_t count, size_t tokens, Similarity similarity)
+{
+    const size_t per_block = std::max<size_t>(1, TILE_TOKENS / std::max<size_t>(1, tokens));
+    std::vector<size_t> starts;
+    for (size_t i = 0; i < count; i += per_block)
+    {
+        starts.push_back(i);
+    }
+    starts.push_back(count);
+    return runTiles(starts, similarity);
+}
+
+// starts: the first document of every block, followed by the number of documents
+template <typename Similarity>
+std::vector<std::priority_queue<AllPairs::Similar>> AllPairs::runTiles(const std::vector<size_t> &starts, Similarity similarity)
+{
+    const size_t n = starts.back();
+    std::vector<TopK> local(pool.size());
+    for (TopK &t : local)
+    {
+        t.heap.resize(n * k);
+        t.count.assign(n, 0);
+    }
+
+    const size_t block_count = starts.size() - 1;
+    tiles = 0;
+
+    for (size_t a = 0; a < block_count; a++)
+    {
+        for (size_t b = a; b < block_count; b++)
+        {
+            tiles++;
+            pool.submit([&, a, b]() {
+                TopK &top = local[pool.currentWorker()];
+                for (size_t i = starts[a]; i < starts[a + 1]; i++)
+                {
+                    for (size_t o = std::max(i + 1, starts[b]); o < starts[b + 1]; o++)
+                    {
+                        top.push(i, k, Similar(similarity(i, o), o));
+                    }
+                }
+            });
+        }
+    }
+    pool.wait();
+
+    // merge the heaps of all threads, every task merges a range of documents
+    std::vector<std::priority_queue<Similar>> similarities(n);
+    const size_t per_task = 1024;
+    for (size_t first = 0; first < n; first += per_task)
+    {
+        pool.submit([&, first]() {
+            std::vector<Similar> merged;
+            for (size_t i = first; i < std::min(first + per_task, n); i++)
+            {
+                merged.clear();
+                for (const TopK &t : local)
+                {
+                    merged.insert(merged.end(), t.heap.begin() + i * k, t.heap.begin() + i * k + t.count[i]);
+                }
+                const size_t keep = std::min<size_t>(k, merged.size());
+                std::partial_sort(merged.begin(), merged.begin() + keep, merged.end(), std::greater<Similar>());
+                similarities[i] = std::priority_queue<Similar>(merged.begin(), merged.begin() + keep);
+            }
+        });
+    }
+    pool.wait();
+
+    return similarities;
+}
+
+#endif
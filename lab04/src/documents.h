@@ -0,0 +1,60 @@
+#ifndef DOCUMENTS_H
+#define DOCUMENTS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "intersection.h"
+
+/*
+All documents as sorted sets of token ids, stored after each other in one array.
+Document i is tokens[offsets[i]] ... tokens[offsets[i+1] - 1], sorted and without duplicates.
+Compared to a std::set per document there is no node per token and no pointer chasing:
+a document is a contiguous range that can be walked through (or intersected) linearly.
+*/
+class Documents
+{
+public:
+    Documents() : offsets(1, 0) {}
+
+    // adds a document, ids doesn't have to be sorted and may contain duplicates
+    void add(std::vector<uint32_t> &ids);
+
+    size_t size() const { return offsets.size() - 1; }
+    size_t size(size_t i) const { return offsets[i + 1] - offsets[i]; }
+    const uint32_t *begin(size_t i) const { return tokens.data() + offsets[i]; }
+    const uint32_t *end(size_t i) const { return tokens.data() + offsets[i + 1]; }
+    // the total number of tokens in all documents
+    size_t tokenCount() const { return tokens.size(); }
+
+    // number of tokens that documents i and j have in common
+    size_t intersection(size_t i, size_t j) const;
+
+    // bytes used by the tokens and the offsets
+    size_t memory_usage() const;
+
+private:
+    std::vector<uint32_t> tokens;
+    std::vector<uint32_t> offsets;
+};
+
+void Documents::add(std::vector<uint32_t> &ids)
+{
+    std::sort(ids.begin(), ids.end());
+    auto last = std::unique(ids.begin(), ids.end());
+    tokens.insert(tokens.end(), ids.begin(), last);
+    offsets.push_back(tokens.size());
+}
+
+size_t Documents::intersection(size_t i, size_t j) const
+{
+    return intersection_size(begin(i), size(i), begin(j), size(j));
+}
+
+size_t Documents::memory_usage() const
+{
+    return tokens.capacity() * sizeof(uint32_t) + offsets.capacity() * sizeof(uint32_t);
+}
+
+#endif
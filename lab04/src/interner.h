@@ -0,0 +1,275 @@
+#ifndef INTERNER_H
+#define INTERNER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 64-bit FNV-1a with a final mix, so that the low bits (used for the table index) depend on every character
+inline uint64_t string_hash64(std::string_view s)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char c : s)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/*
+Maps strings to ids 0, 1, 2, ... in the order they are first seen.
+The strings are copied after each other into an arena of blocks that double from 1 KiB up to 64 KiB (a
+longer string gets a block of its own). A block is never moved or freed while the interner exists, so the
+string_view that lookup returns stays valid for the lifetime of the interner, also after more strings are added.
+The hash table uses open addressing with linear probing: every slot holds the id + 1 (0 is an empty slot)
+and the upper bits of the hash, so a lookup only compares strings whose hash matches. The table is grown
+to keep the load below 1/2; an id never changes once it is handed out.
+*/
+class StringInterner
+{
+public:
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+    explicit StringInterner(size_t expected = 1024);
+
+    // the id of s, s is added if it has not been seen before
+    uint32_t intern(std::string_view s) { return intern(s, string_hash64(s)); }
+    uint32_t intern(std::string_view s, uint64_t hash);
+    // the id of s, or NOT_FOUND
+    uint32_t find(std::string_view s) const { return find(s, string_hash64(s)); }
+    uint32_t find(std::string_view s, uint64_t hash) const;
+
+    // the string of an id, valid as long as the interner exists
+    std::string_view lookup(uint32_t id) const { return strings[id]; }
+    size_t size() const { return strings.size(); }
+    // bytes used by the arena, the views into it and the table
+    size_t memory_usage() const;
+
+private:
+    struct Slot
+    {
+        uint32_t id_plus_one;
+        uint32_t hash_tag;
+    };
+
+    static constexpr size_t FIRST_BLOCK = 1024;
+    static constexpr size_t MAX_BLOCK = 64 * 1024;
+
+    size_t probe(std::string_view s, uint64_t hash) const;
+    void grow();
+    // copy s into the arena
+    std::string_view store(std::string_view s);
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    // free space at the end of the last block
+    char *block_free = nullptr;
+    size_t block_left = 0;
+    // size of the last regular block, 0 before the first one
+    size_t block_size = 0;
+    size_t arena_bytes = 0;
+    // strings[id] points into the arena
+    std::vector<std::string_view> strings;
+    std::vector<Slot> table;
+    size_t mask;
+};
+
+StringInterner::StringInterner(size_t expected)
+{
+    size_t capacity = 16;
+    while (capacity < 2 * expected)
+    {
+        capacity *= 2;
+    }
+    table.assign(capacity, Slot{0, 0});
+    mask = capacity - 1;
+}
+
+std::string_view StringInterner::store(std::string_view s)
+{
+    if (s.size() > block_left)
+    {
+        // the rest of the last block stays unused
+        block_size = block_size == 0 ? FIRST_BLOCK : std::min(2 * block_size, MAX_BLOCK);
+        const size_t size = std::max(block_size, s.size());
+        blocks.emplace_back(new char[size]);
+        block_free = blocks.back().get();
+        block_left = size;
+        arena_bytes += size;
+    }
+    char *copy = block_free;
+    std::copy(s.begin(), s.end(), copy);
+    block_free += s.size();
+    block_left -= s.size();
+    return std::string_view(copy, s.size());
+}
+
+// index of the slot that holds s, or of the empty slot where it belongs
+size_t StringInterner::probe(std::string_view s, uint64_t hash) const
+{
+    const uint32_t tag = hash >> 32;
+    size_t i = hash & mask;
+    while (table[i].id_plus_one != 0)
+    {
+        if (table[i].hash_tag == tag && lookup(table[i].id_plus_one - 1) == s)
+        {
+            return i;
+        }
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+uint32_t StringInterner::find(std::string_view s, uint64_t hash) const
+{
+    const Slot &slot = table[probe(s, hash)];
+    return slot.id_plus_one == 0 ? NOT_FOUND : slot.id_plus_one - 1;
+}
+
+uint32_t StringInterner::intern(std::string_view s, uint64_t hash)
+{
+    size_t i = probe(s, hash);
+    if (table[i].id_plus_one != 0)
+    {
+        return table[i].id_plus_one - 1;
+    }
+
+    const uint32_t id = size();
+    strings.push_back(store(s));
+    table[i] = Slot{id + 1, static_cast<uint32_t>(hash >> 32)};
+
+    if (2 * size() > table.size())
+    {
+        grow();
+    }
+    return id;
+}
+
+void StringInterner::grow()
+{
+    std::vector<Slot> old(2 * table.size(), Slot{0, 0});
+    old.swap(table);
+    mask = table.size() - 1;
+
+    for (const Slot &slot : old)
+    {
+        if (slot.id_plus_one != 0)
+        {
+            size_t i = string_hash64(lookup(slot.id_plus_one - 1)) & mask;
+            while (table[i].id_plus_one != 0)
+            {
+                i = (i + 1) & mask;
+            }
+            table[i] = slot;
+        }
+    }
+}
+
+size_t StringInterner::memory_usage() const
+{
+    return arena_bytes + blocks.capacity() * sizeof(blocks[0]) + strings.capacity() * sizeof(std::string_view)
+           + table.capacity() * sizeof(Slot);
+}
+
+/*
+A StringInterner that can be used by several threads at once.
+The strings are spread over 64 shards by their hash, each shard is a StringInterner behind a reader-writer
+lock: a string that is already known only takes a shared lock, only adding one takes the shard exclusively.
+The id of a string is its id within the shard times 64 plus the shard number, so ids are stable and unique
+but not consecutive. The view that lookup returns points into the arena of the shard, which never moves, so it
+stays valid for the lifetime of the interner while other threads keep adding strings.
+*/
+class ConcurrentStringInterner
+{
+public:
+    static constexpr uint32_t NOT_FOUND = StringInterner::NOT_FOUND;
+
+    explicit ConcurrentStringInterner(size_t expected = 1024);
+
+    uint32_t intern(std::string_view s);
+    uint32_t find(std::string_view s) const;
+    std::string_view lookup(uint32_t id) const;
+    size_t size() const;
+
+private:
+    static constexpr int SHARD_BITS = 6;
+    static constexpr int SHARDS = 1 << SHARD_BITS;
+
+    struct Shard
+    {
+        mutable std::shared_mutex mutex;
+        StringInterner strings;
+
+        explicit Shard(size_t expected) : strings(expected) {}
+    };
+
+    // the shard is chosen by bits of the hash that the table index within the shard doesn't use much
+    static int shard_of(uint64_t hash) { return (hash >> 26) & (SHARDS - 1); }
+
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+ConcurrentStringInterner::ConcurrentStringInterner(size_t expected)
+{
+    for (int i = 0; i < SHARDS; i++)
+    {
+        shards.push_back(std::make_unique<Shard>(expected / SHARDS + 1));
+    }
+}
+
+uint32_t ConcurrentStringInterner::intern(std::string_view s)
+{
+    const uint64_t hash = string_hash64(s);
+    const int shard = shard_of(hash);
+    Shard &sh = *shards[shard];
+
+    uint32_t local;
+    {
+        std::shared_lock<std::shared_mutex> lock(sh.mutex);
+        local = sh.strings.find(s, hash);
+    }
+    if (local == NOT_FOUND)
+    {
+        std::unique_lock<std::shared_mutex> lock(sh.mutex);
+        local = sh.strings.intern(s, hash);
+    }
+    return (local << SHARD_BITS) | shard;
+}
+
+uint32_t ConcurrentStringInterner::find(std::string_view s) const
+{
+    const uint64_t hash = string_hash64(s);
+    const int shard = shard_of(hash);
+    std::shared_lock<std::shared_mutex> lock(shards[shard]->mutex);
+    const uint32_t local = shards[shard]->strings.find(s, hash);
+    return local == NOT_FOUND ? NOT_FOUND : (local << SHARD_BITS) | shard;
+}
+
+std::string_view ConcurrentStringInterner::lookup(uint32_t id) const
+{
+    const Shard &sh = *shards[id & (SHARDS - 1)];
+    // the lock is only needed to read the view, the characters themselves never move
+    std::shared_lock<std::shared_mutex> lock(sh.mutex);
+    return sh.strings.lookup(id >> SHARD_BITS);
+}
+
+size_t ConcurrentStringInterner::size() const
+{
+    size_t total = 0;
+    for (const auto &sh : shards)
+    {
+        std::shared_lock<std::shared_mutex> lock(sh->mutex);
+        total += sh->strings.size();
+    }
+    return total;
+}
+
+#endif
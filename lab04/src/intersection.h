@@ -0,0 +1,112 @@
+#ifndef INTERSECTION_H
+#define INTERSECTION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+Number of elements that two sorted arrays without duplicates have in common.
+Only the count is computed: nothing is allocated and the intersection itself is never stored.
+*/
+
+// the classic merge: walk through both arrays at the same time
+size_t intersection_size_merge(const uint32_t *a, size_t na, const uint32_t *b, size_t nb)
+{
+    const uint32_t *a_end = a + na, *b_end = b + nb;
+    size_t count = 0;
+    while (a != a_end && b != b_end)
+    {
+        // no branches on the comparison, those are unpredictable
+        const uint32_t x = *a, y = *b;
+        count += (x == y);
+        a += (x <= y);
+        b += (y <= x);
+    }
+    return count;
+}
+
+// For every element of the small array, search it in the large one: first double the step until it is passed,
+// then binary search in the last step. O(ns log(nl / ns)), the best choice if one array is much larger.
+size_t intersection_size_galloping(const uint32_t *small, size_t ns, const uint32_t *large, size_t nl)
+{
+    const uint32_t *large_end = large + nl;
+    size_t count = 0;
+    for (size_t i = 0; i < ns && large != large_end; i++)
+    {
+        const uint32_t x = small[i];
+
+        size_t step = 1;
+        while (step < (size_t)(large_end - large) && large[step] < x)
+        {
+            large += step;
+            step *= 2;
+        }
+        large = std::lower_bound(large, std::min(large + step + 1, large_end), x);
+
+        if (large != large_end && *large == x)
+        {
+            count++;
+            large++;
+        }
+    }
+    return count;
+}
+
+#ifdef __SSE2__
+// Compares blocks of 4 elements of a with blocks of 4 elements of b: b is compared 4 times, each time rotated
+// by one element, so all 16 pairs are tested. Because there are no duplicates, every element matches at most once
+// and the number of set bits is the number of common elements. The block with the smallest last element is
+// replaced by the next one (both if they are equal). The rest is merged.
+size_t intersection_size_sse2(const uint32_t *a, size_t na, const uint32_t *b, size_t nb)
+{
+    const size_t a_blocks = na & ~(size_t)3, b_blocks = nb & ~(size_t)3;
+    size_t i = 0, j = 0, count = 0;
+
+    while (i < a_blocks && j < b_blocks)
+    {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+
+        __m128i equal = _mm_cmpeq_epi32(va, vb);
+        equal = _mm_or_si128(equal, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        equal = _mm_or_si128(equal, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        equal = _mm_or_si128(equal, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+
+        const uint32_t a_last = a[i + 3], b_last = b[j + 3];
+        i += (a_last <= b_last) * 4;
+        j += (b_last <= a_last) * 4;
+    }
+
+    return count + intersection_size_merge(a + i, na - i, b + j, nb - j);
+}
+#endif
+
+// above this size ratio galloping beats comparing blocks
+constexpr size_t GALLOPING_RATIO = 16;
+
+// chooses the kernel by the sizes of the arrays
+size_t intersection_size(const uint32_t *a, size_t na, const uint32_t *b, size_t nb)
+{
+    if (na > nb)
+    {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (na * GALLOPING_RATIO < nb)
+    {
+        return intersection_size_galloping(a, na, b, nb);
+    }
+#ifdef __SSE2__
+    return intersection_size_sse2(a, na, b, nb);
+#else
+    return intersection_size_merge(a, na, b, nb);
+#endif
+}
+
+#endif
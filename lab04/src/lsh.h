@@ -0,0 +1,168 @@
+#ifndef LSH_H
+#define LSH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/*
+Banding of MinHash signatures: the first bands * rows positions of a signature are cut into bands of rows
+positions. Two documents with Jaccard index s have the same values in a given band with probability s^rows,
+so they are a candidate pair (equal in at least one band) with probability 1 - (1 - s^rows)^bands.
+This S-curve rises steepest around threshold() = (1 / bands)^(1 / rows).
+The banding only needs signatures of a fixed length that match position by position; computing them is up to
+minhash.h, this header does not depend on it.
+*/
+struct LshParameters
+{
+    int bands;
+    int rows;
+
+    // 1 without bands or rows: then no pair is ever a candidate
+    double threshold() const { return bands > 0 && rows > 0 ? std::pow(1.0 / bands, 1.0 / rows) : 1.0; }
+    double probability(double s) const { return 1 - std::pow(1 - std::pow(s, rows), bands); }
+
+    // The parameters with the most rows per band (the fewest candidates) that fit in a signature of
+    // "length" positions and find a pair with similarity "threshold" with at least probability "recall".
+    // Both must be in (0, 1). Outside of that the extremes are used: one band of all positions (only equal
+    // signatures) for a threshold >= 1 or a recall <= 0, and bands of one row (the most candidates) for a
+    // threshold <= 0 or a recall >= 1.
+    static LshParameters forThreshold(double threshold, int length, double recall = 0.95);
+};
+
+LshParameters LshParameters::forThreshold(double threshold, int length, double recall)
+{
+    // the formula below takes log(0) at these ends; !(x > 0) also catches NaN
+    if (threshold >= 1 || recall <= 0)
+    {
+        return LshParameters{1, length};
+    }
+    if (!(threshold > 0) || !(recall < 1))
+    {
+        return LshParameters{length, 1};
+    }
+
+    LshParameters best{length, 1};
+    for (int rows = 1; rows <= length; rows++)
+    {
+        // smallest number of bands that reaches the recall
+        // when threshold^rows rounds to 0 this divides by log(1) = 0 and gives -infinity
+        const double bands = std::ceil(std::log(1 - recall) / std::log(1 - std::pow(threshold, rows)));
+        if (bands >= 1 && bands * rows <= length)
+        {
+            best = LshParameters{(int)bands, rows};
+        }
+    }
+    return best;
+}
+
+/*
+The buckets of every band: for each band the (hash of the band, document) pairs, sorted, so that the documents
+of a bucket are next to each other.
+*/
+class LshIndex
+{
+public:
+    // signatures: "length" positions per document, document i at i * length
+    LshIndex(const std::vector<uint32_t> &signatures, int length, LshParameters parameters);
+
+    size_t size() const { return documents; }
+    const LshParameters &parameters() const { return p; }
+
+    // calls f(i, o) once for every candidate pair i < o
+    template <typename F>
+    void forEachCandidate(F f) const;
+    bool isCandidate(uint32_t i, uint32_t o) const;
+
+private:
+    // does the pair share a band before band "band"?
+    bool sharesEarlierBand(uint32_t i, uint32_t o, int band) const;
+
+    size_t documents;
+    LshParameters p;
+    // hash of band j of document i at i * bands + j
+    std::vector<uint32_t> hashes;
+    // for every band: hash << 32 | document, sorted
+    std::vector<std::vector<uint64_t>> buckets;
+};
+
+LshIndex::LshIndex(const std::vector<uint32_t> &signatures, int length, LshParameters parameters)
+    : documents(signatures.size() / length), p(parameters), hashes(documents * p.bands), buckets(p.bands)
+{
+    for (size_t i = 0; i < documents; i++)
+    {
+        const uint32_t *signature = signatures.data() + i * length;
+        for (int j = 0; j < p.bands; j++)
+        {
+            // FNV-1a over the rows of the band, the band number included so that equal rows in
+            // different bands do not give the same hash
+            uint64_t hash = 0xcbf29ce484222325ULL ^ j;
+            for (int r = 0; r < p.rows; r++)
+            {
+                hash = (hash ^ signature[j * p.rows + r]) * 0x100000001b3ULL;
+            }
+            hashes[i * p.bands + j] = hash ^ (hash >> 32);
+        }
+    }
+
+    for (int j = 0; j < p.bands; j++)
+    {
+        buckets[j].resize(documents);
+        for (size_t i = 0; i < documents; i++)
+        {
+            buckets[j][i] = (uint64_t)hashes[i * p.bands + j] << 32 | i;
+        }
+        std::sort(buckets[j].begin(), buckets[j].end());
+    }
+}
+
+bool LshIndex::sharesEarlierBand(uint32_t i, uint32_t o, int band) const
+{
+    for (int j = 0; j < band; j++)
+    {
+        if (hashes[i * p.bands + j] == hashes[o * p.bands + j])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LshIndex::isCandidate(uint32_t i, uint32_t o) const
+{
+    return sharesEarlierBand(i, o, p.bands);
+}
+
+template <typename F>
+void LshIndex::forEachCandidate(F f) const
+{
+    for (int j = 0; j < p.bands; j++)
+    {
+        const std::vector<uint64_t> &bucket = buckets[j];
+        for (size_t first = 0; first < bucket.size();)
+        {
+            size_t last = first + 1;
+            while (last < bucket.size() && (bucket[last] >> 32) == (bucket[first] >> 32))
+            {
+                last++;
+            }
+
+            // the documents of a bucket are sorted, so x < y; a pair is only reported in its first common band
+            for (size_t x = first; x < last; x++)
+            {
+                for (size_t y = x + 1; y < last; y++)
+                {
+                    const uint32_t i = bucket[x], o = bucket[y];
+                    if (!sharesEarlierBand(i, o, j))
+                    {
+                        f(i, o);
+                    }
+                }
+            }
+            first = last;
+        }
+    }
+}
+
+#endif
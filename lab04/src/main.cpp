@@ -10,8 +10,17 @@
 #include <algorithm>
 #include <string>
 #include <limits.h>
+#include <cmath>
+#include <atomic>
+#include <thread>
 
 #include "hashfunctions.h"
+#include "interner.h"
+#include "documents.h"
+#include "threadpool.h"
+#include "allpairs.h"
+#include "minhash.h"
+#include "lsh.h"
 
 /*
 Reads all the files in "folder". Assumes that they are named 0.py, 1.py, ...
@@ -90,6 +99,82 @@ std::vector<std::set<int>> replaceWithUniqueId(const std::vector<std::set<std::s
     return contents;
 }
 
+// Same ids as replaceWithUniqueId, but looked up in a hash table instead of searched for in a vector.
+std::vector<std::set<int>> replaceWithInternedId(const std::vector<std::set<std::string>> &input, StringInterner &interner)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::set<int>> contents(input.size());
+
+    for(int i = 0; i < input.size(); i++) {
+        for(const std::string &s : input[i]) {
+            contents[i].insert(interner.intern(s));
+        }
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    std::cout << "Replacing words with interned IDs took " << duration.count() << " ms" << std::endl;
+    return contents;
+}
+
+// The documents are divided over "threads" threads that share one interner.
+// The ids are unique and stable, but depend on the order in which the threads see the n-grams.
+std::vector<std::set<int>> replaceWithInternedIdConcurrent(const std::vector<std::set<std::string>> &input, ConcurrentStringInterner &interner, int threads)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::set<int>> contents(input.size());
+
+    // every thread takes the next document that nobody has started yet
+    std::atomic<int> next(0);
+    auto work = [&]() {
+        for(int i = next++; i < input.size(); i = next++) {
+            for(const std::string &s : input[i]) {
+                contents[i].insert(interner.intern(s));
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; t++) {
+        workers.emplace_back(work);
+    }
+    for(std::thread &worker : workers) {
+        worker.join();
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    std::cout << "Replacing words with interned IDs on " << threads << " threads took " << duration.count() << " ms" << std::endl;
+    return contents;
+}
+
+// Runs the three ways of replacing n-grams by ids and checks that they agree.
+void compareInterning(const std::vector<std::set<std::string>> &input)
+{
+    std::vector<std::set<int>> byFind = replaceWithUniqueId(input);
+
+    StringInterner interner;
+    std::vector<std::set<int>> byInterner = replaceWithInternedId(input, interner);
+    std::cout << interner.size() << " unique n-grams, " << interner.memory_usage() / 1024 << " KiB" << std::endl;
+
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    ConcurrentStringInterner concurrent;
+    std::vector<std::set<int>> byConcurrent = replaceWithInternedIdConcurrent(input, concurrent, threads);
+
+    // the concurrent ids differ, so compare the n-grams they stand for
+    bool same = byFind == byInterner && concurrent.size() == interner.size();
+    for(int i = 0; i < input.size() && same; i++) {
+        std::set<std::string> words;
+        for(int id : byConcurrent[i]) {
+            words.insert(std::string(concurrent.lookup(id)));
+        }
+        same = words == input[i];
+    }
+    std::cout << "Interned IDs " << (same ? "match" : "DO NOT match") << " the original IDs" << std::endl;
+}
+
 // Replaces each word with its hash code.
 template <unsigned int (*hashfunction)(const std::string &)>
 std::vector<std::set<int>> replaceWithHash(const std::vector<std::set<std::string>> &input)
@@ -111,6 +196,51 @@ std::vector<std::set<int>> replaceWithHash(const std::vector<std::set<std::strin
     return contents;
 }
 
+// Replaces each word with its hash code, all documents in one flat Documents.
+template <unsigned int (*hashfunction)(const std::string &)>
+Documents replaceWithHashFlat(const std::vector<std::set<std::string>> &input)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Documents contents;
+    std::vector<uint32_t> ids;
+
+    for(int i = 0; i < input.size(); i++) {
+        ids.clear();
+        for(const std::string &s : input[i]) {
+            ids.push_back(hashfunction(s));
+        }
+        contents.add(ids);
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    std::cout << "Replacing words with hash values (flat) took " << duration.count() << " ms" << std::endl;
+    return contents;
+}
+
+// Replaces each word with its interned id, all documents in one flat Documents.
+Documents replaceWithInternedIdFlat(const std::vector<std::set<std::string>> &input, StringInterner &interner)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Documents contents;
+    std::vector<uint32_t> ids;
+
+    for(int i = 0; i < input.size(); i++) {
+        ids.clear();
+        for(const std::string &s : input[i]) {
+            ids.push_back(interner.intern(s));
+        }
+        contents.add(ids);
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    std::cout << "Replacing words with interned IDs (flat) took " << duration.count() << " ms" << std::endl;
+    return contents;
+}
+
 // Print_collisions: boolean value that decides if the collisions need to be printed.
 template <unsigned int (*hashfunction)(const std::string &)>
 void findCollisions(const std::vector<std::set<std::string>> &input, bool print_collisions)
@@ -118,10 +248,10 @@ void findCollisions(const std::vector<std::set<std::string>> &input, bool print_
     std::vector<std::string> unique_input;
 
     // get all unique n-grams
+    StringInterner interner;
     for(int i = 0; i < input.size(); i++) {
-        for(std::string s : input[i]) {
-            std::vector<std::string>::iterator it = find(unique_input.begin(), unique_input.end(), s);
-            if(it == unique_input.end()) {
+        for(const std::string &s : input[i]) {
+            if(interner.intern(s) == unique_input.size()) {
                 unique_input.push_back(s);
             }
         }
@@ -151,7 +281,7 @@ void findCollisions(const std::vector<std::set<std::string>> &input, bool print_
 
 // Get the intersecting set between two sets.
 template <typename T>
-std::set<T> get_intersection(std::set<T> set1, std::set<T> set2)
+std::set<T> get_intersection(const std::set<T> &set1, const std::set<T> &set2)
 { 
     std::set<T> intersection;
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), inserter(intersection, intersection.begin()));
@@ -186,6 +316,29 @@ std::vector<std::priority_queue<std::pair<double, int>>> jaccard(const std::vect
     return similarities;
 }
 
+// Calculate all jaccard indices for documents stored as flat sorted arrays.
+std::vector<std::priority_queue<std::pair<double, int>>> jaccard(const Documents &contents)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::priority_queue<std::pair<double, int>>> similarities(contents.size());
+
+    for(int i = 0; i < contents.size(); i++) {
+        for(int o = i+1; o < contents.size(); o++) {
+            int intersection_size = contents.intersection(i, o);
+            int union_size = contents.size(i) + contents.size(o) - intersection_size;
+            double jaccard_index = intersection_size / (double)union_size;
+
+            similarities[i].push(std::make_pair(jaccard_index, o));
+        }
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    std::cout << "Calculating the Jaccard index (flat) took " << duration.count() << " ms" << std::endl;
+    return similarities;
+}
+
 // Show for each document the most similar other documents. Each document only needs to occur once in the list.
 // Ignore the document if the similarity score is lower than "threshold" 
 void showSummary(std::vector<std::priority_queue<std::pair<double, int>>> &similarities, double threshold)
@@ -219,98 +372,419 @@ void showSummary(std::vector<std::priority_queue<std::pair<double, int>>> &simil
     std::cout << std::endl;
 }
 
-// credits: https://www.geeksforgeeks.org/program-to-find-the-next-prime-number/
-bool is_prime(int n)
+// Compute an estimated jaccard index for each two documents using minhashing.
+// Every document gets a signature of n min hashes and the estimate is the fraction of positions where two
+// signatures are equal (see minhash.h).
+std::vector<std::priority_queue<std::pair<double, int>>> minhashing(const std::vector<std::set<int>> &contents, int n)
 {
-    // Corner cases
-    if (n <= 1) return false;
-    if (n <= 3) return true;
+    auto start = std::chrono::high_resolution_clock::now();
 
-    // This is checked so that we can skip 
-    // middle five numbers in below loop
-    if (n%2 == 0 || n%3 == 0) return false;
+    std::vector<std::priority_queue<std::pair<double, int>>> similarities(contents.size());
+
+    std::random_device dev;
+    MinHash<uint32_t> minhash(n, dev());
 
-    for (int i = 5; i*i <= n; i = i+6)
-        if (n%i == 0 || n%(i+2) == 0)
-            return false;
+    // compute the signatures of all documents
+    std::vector<uint32_t> signatures(contents.size() * n);
+    for(int i = 0; i < contents.size(); i++) {
+        std::vector<uint32_t> ids(contents[i].begin(), contents[i].end());
+        minhash.signature(ids.data(), ids.data() + ids.size(), &signatures[i * n]);
+    }
 
-    return true;
+    // compare all documents their signatures position by position to estimate the jaccard index
+    for(int i = 0; i < contents.size(); i++) {
+        for(int o = i+1; o < contents.size(); o++) {
+            double estimated_jaccard_index = minhash.similarity(&signatures[i * n], &signatures[o * n]);
+            similarities[i].push(std::make_pair(estimated_jaccard_index, o));
+        }
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    std::cout << "Minhashing took " << duration.count() << " ms" << std::endl;
+    return similarities;
 }
 
-int get_next_prime(int n)
+// Minhashing on flat documents.
+std::vector<std::priority_queue<std::pair<double, int>>> minhashing(const Documents &contents, int n)
 {
     auto start = std::chrono::high_resolution_clock::now();
 
-    bool found = false;
-    while(!found)
-        found = is_prime(++n);
+    std::vector<std::priority_queue<std::pair<double, int>>> similarities(contents.size());
+
+    std::random_device dev;
+    MinHash<uint32_t> minhash(n, dev());
+    std::vector<uint32_t> signatures = minhash.signatures(contents);
+
+    for(int i = 0; i < contents.size(); i++) {
+        for(int o = i+1; o < contents.size(); o++) {
+            double estimated_jaccard_index = minhash.similarity(&signatures[i * n], &signatures[o * n]);
+            similarities[i].push(std::make_pair(estimated_jaccard_index, o));
+        }
+    }
 
     auto stop = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
-    std::cout << "Computing the next prime took " << duration.count() << " ms" << std::endl;
+    std::cout << "Minhashing (flat) took " << duration.count() << " ms" << std::endl;
+    return similarities;
+}
+
+// The k most similar documents by Jaccard index, all pairs compared on the threads of pool.
+std::vector<std::priority_queue<std::pair<double, int>>> jaccard(const Documents &contents, ThreadPool &pool, int k)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    AllPairs engine(pool, k);
+    std::vector<std::priority_queue<std::pair<double, int>>> similarities = engine.run(contents, [&](int i, int o) {
+        int intersection_size = contents.intersection(i, o);
+        int union_size = contents.size(i) + contents.size(o) - intersection_size;
+        return intersection_size / (double)union_size;
+    });
 
-    return n;
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    std::cout << "Calculating the top " << k << " Jaccard indices on " << pool.size() << " threads (" << engine.tileCount() << " tiles) took " << duration.count() << " ms" << std::endl;
+    return similarities;
 }
 
-// Compute an estimated jaccard index for each two documents using minhashing.
-std::vector<std::priority_queue<std::pair<double, int>>> minhashing(const std::vector<std::set<int>> &contents, int n)
+// The k most similar documents by minhashing, all pairs compared on the threads of pool.
+std::vector<std::priority_queue<std::pair<double, int>>> minhashing(const Documents &contents, int n, ThreadPool &pool, int k)
 {
     auto start = std::chrono::high_resolution_clock::now();
 
-    std::vector<std::priority_queue<std::pair<double, int>>> similarities(contents.size());
+    std::random_device dev;
+    MinHash<uint32_t> minhash(n, dev());
+    std::vector<uint32_t> signatures = minhash.signatures(contents);
+    AllPairs engine(pool, k);
+    std::vector<std::priority_queue<std::pair<double, int>>> similarities = engine.run(contents.size(), n, [&](int i, int o) {
+        return minhash.similarity(&signatures[i * n], &signatures[o * n]);
+    });
 
-    // find the maximum hash value over all sets
-    int max = 0;
-    for(int i = 0; i < contents.size(); i++) {
-        int x = *(std::max_element(contents[i].begin(), contents[i].end()));
-        if(x > max) max = x;
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    std::cout << "Minhashing the top " << k << " on " << pool.size() << " threads took " << duration.count() << " ms" << std::endl;
+    return similarities;
+}
+
+// Estimated heap memory of sets of ints: every element is a red-black tree node (color, 3 pointers and the value).
+size_t setMemory(const std::vector<std::set<int>> &sets)
+{
+    size_t node = (4 * sizeof(void *) + sizeof(int) + 15) / 16 * 16;
+    size_t memory = sets.size() * sizeof(std::set<int>);
+    for(const std::set<int> &set : sets) {
+        memory += set.size() * node;
     }
+    return memory;
+}
 
-    // generate a and b values for each k
-    std::random_device dev;
-    std::mt19937 rng(dev());
-    std::uniform_int_distribution<std::mt19937::result_type> dist(0, max-1);
-    std::vector<std::pair<int, int>> rands(n);
-    for(int k = 0; k < n; k++) {
-        int a = dist(rng);
-        int b = dist(rng);
-        rands[k] = std::make_pair(a, b);
+// Compares std::set documents with flat Documents on one corpus: memory, and the time of the steps that use them.
+void compareDocuments(const char *folder)
+{
+    std::cout << std::endl << "=== " << folder << " ===" << std::endl;
+    std::vector<std::set<std::string>> contents = readDatafiles(folder);
+
+    std::vector<std::set<int>> contentsId = replaceWithHash<good_hash>(contents);
+    Documents documents = replaceWithHashFlat<good_hash>(contents);
+    std::cout << contents.size() << " files, " << documents.tokenCount() << " tokens: std::set " << setMemory(contentsId) / 1024
+              << " KiB, flat " << documents.memory_usage() / 1024 << " KiB" << std::endl;
+
+    std::vector<std::priority_queue<std::pair<double, int>>> bySet = jaccard<int>(contentsId);
+    std::vector<std::priority_queue<std::pair<double, int>>> byFlat = jaccard(documents);
+    bool same = true;
+    for(int i = 0; i < contents.size() && same; i++) {
+        same = bySet[i].size() == byFlat[i].size() && (bySet[i].empty() || bySet[i].top() == byFlat[i].top());
     }
+    std::cout << "Jaccard indices " << (same ? "match" : "DO NOT match") << std::endl;
 
-    // c is the next prime number after the max hash value
-    int c = get_next_prime(max);
+    minhashing(contentsId, 50);
+    minhashing(documents, 50);
+}
 
-    // compute all k min hashes of all documents
-    std::vector<std::set<int>> min_hash_sets(contents.size());
-    for(int i = 0; i < contents.size(); i++) {
-        std::set<int> min_hashes;
-        for(int k = 0; k < n; k++) {
-            int a = rands[k].first;
-            int b = rands[k].second;
-
-            int min_hash = INT_MAX;
-            for(int x : contents[i]) {
-                int hash = (a*x + b) % c;
-                if(min_hash > hash) min_hash = hash;
+// Intersects every pair of documents with kernel and prints the time and the sum of the intersection sizes.
+template <typename Kernel>
+void timeAllPairs(const char *name, const Documents &documents, Kernel kernel)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    size_t total = 0;
+    for(int i = 0; i < documents.size(); i++) {
+        for(int o = i+1; o < documents.size(); o++) {
+            total += kernel(documents.begin(i), documents.size(i), documents.begin(o), documents.size(o));
+        }
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << std::left << std::setw(24) << name << std::right << std::setw(10) << duration.count() << " us" << std::setw(12) << total << std::endl;
+}
+
+// Compares the intersection kernels on all pairs of documents of a corpus.
+// The second table intersects each document with one extra document that contains every token of the corpus,
+// which gives pairs with very different sizes.
+void benchmarkIntersection(const char *folder)
+{
+    std::cout << std::endl << "=== " << folder << " ===" << std::endl;
+    std::vector<std::set<std::string>> contents = readDatafiles(folder);
+    std::vector<std::set<int>> contentsId = replaceWithHash<good_hash>(contents);
+    Documents documents = replaceWithHashFlat<good_hash>(contents);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t total = 0;
+    for(int i = 0; i < contentsId.size(); i++) {
+        for(int o = i+1; o < contentsId.size(); o++) {
+            total += get_intersection(contentsId[i], contentsId[o]).size();
+        }
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << std::left << std::setw(24) << "std::set_intersection" << std::right << std::setw(10) << duration.count() << " us" << std::setw(12) << total << std::endl;
+
+    timeAllPairs("merge", documents, intersection_size_merge);
+    timeAllPairs("galloping", documents, intersection_size_galloping);
+#ifdef __SSE2__
+    timeAllPairs("sse2", documents, intersection_size_sse2);
+#endif
+    timeAllPairs("intersection_size", documents, intersection_size);
+
+    // every document against all tokens of the corpus, both orders
+    Documents skewed;
+    std::vector<uint32_t> all;
+    for(int i = 0; i < documents.size(); i++) {
+        all.insert(all.end(), documents.begin(i), documents.end(i));
+    }
+    for(int i = 0; i < documents.size(); i++) {
+        std::vector<uint32_t> ids(documents.begin(i), documents.end(i));
+        skewed.add(ids);
+        skewed.add(all);
+    }
+    std::cout << "skewed pairs (" << skewed.size(1) << " tokens):" << std::endl;
+    auto skewedPairs = [&](const char *name, size_t (*kernel)(const uint32_t *, size_t, const uint32_t *, size_t)) {
+        auto start = std::chrono::high_resolution_clock::now();
+        size_t total = 0;
+        for(int i = 0; i < skewed.size(); i += 2) {
+            total += kernel(skewed.begin(i), skewed.size(i), skewed.begin(i + 1), skewed.size(i + 1));
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(10) << duration.count() << " us" << std::setw(12) << total << std::endl;
+    };
+    skewedPairs("merge", intersection_size_merge);
+    skewedPairs("galloping", intersection_size_galloping);
+#ifdef __SSE2__
+    skewedPairs("sse2", intersection_size_sse2);
+#endif
+    skewedPairs("intersection_size", intersection_size);
+}
+
+// All corpora after each other, "replication" times, as one flat Documents.
+Documents allCorpora(int replication)
+{
+    Documents corpus;
+    for(const char *folder : {"src/quiz/", "src/isbn/", "src/synoniemen/", "src/warmste-week/", "src/yahtzee/"}) {
+        Documents documents = replaceWithHashFlat<good_hash>(readDatafiles(folder));
+        for(int r = 0; r < replication; r++) {
+            for(int i = 0; i < documents.size(); i++) {
+                std::vector<uint32_t> ids(documents.begin(i), documents.end(i));
+                corpus.add(ids);
             }
-            min_hashes.insert(min_hash);
         }
-        min_hash_sets[i] = min_hashes;
     }
+    return corpus;
+}
 
-    // compare all documents their min hashes and use the intersection to estimate the jaccard index
-    for(int i = 0; i < contents.size(); i++) {
-        for(int o = i+1; o < contents.size(); o++) {
-            std::set<int> intersection = get_intersection(min_hash_sets[i], min_hash_sets[o]);
-            double estimated_jaccard_index = intersection.size() / (double)n;
-            similarities[i].push(std::make_pair(estimated_jaccard_index, o));
+// Runs the parallel all-pairs Jaccard on 1, 2, 4, ... threads up to the number of cores and checks that
+// every thread count finds the same top k.
+void benchmarkAllPairs(int replication, int k)
+{
+    Documents corpus = allCorpora(replication);
+    std::cout << std::endl << "All corpora " << replication << " times: " << corpus.size() << " documents, " << corpus.tokenCount() << " tokens" << std::endl;
+
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::priority_queue<std::pair<double, int>>> reference;
+    double single = 0;
+    for(int threads = 1; ; threads = std::min(2 * threads, cores)) {
+        ThreadPool pool(threads);
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::priority_queue<std::pair<double, int>>> similarities = jaccard(corpus, pool, k);
+        auto stop = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(stop - start).count();
+
+        bool same = true;
+        if(threads == 1) {
+            reference = similarities;
+            single = seconds;
+        } else {
+            for(int i = 0; i < corpus.size() && same; i++) {
+                same = similarities[i].size() == reference[i].size() && (similarities[i].empty() || similarities[i].top() == reference[i].top());
+            }
+        }
+        std::cout << std::setw(4) << threads << " threads: speedup " << std::fixed << std::setprecision(2) << single / seconds
+                  << std::defaultfloat << std::setprecision(6) << (same ? "" : ", DIFFERENT result") << std::endl;
+
+        if(threads == cores) break;
+    }
+}
+
+// "count" documents made from copies of the documents of base. Every 4 copies of base form a group with its own
+// vocabulary (the token ids are remapped per group), so documents of different groups have nothing in common.
+// Copy c of a group replaces each token by a random new one with probability 0.05 * c, which gives Jaccard
+// indices between the copies of a document from about 0.6 to 1.
+Documents syntheticCorpus(const Documents &base, size_t count)
+{
+    Documents corpus;
+    std::mt19937 rng(42);
+    std::vector<uint32_t> ids;
+
+    for(size_t d = 0; d < count; d++) {
+        size_t original = d % base.size();
+        size_t copy = d / base.size();
+        uint64_t group = copy / 4;
+        double replace = 0.05 * (copy % 4);
+
+        ids.clear();
+        for(const uint32_t *x = base.begin(original); x != base.end(original); x++) {
+            uint64_t id = *x;
+            if(std::generate_canonical<double, 32>(rng) < replace) id = rng();
+            // remap the id for the group
+            id = (id + group * 0x9e3779b97f4a7c15ULL) * 0xff51afd7ed558ccdULL;
+            ids.push_back(id >> 32);
         }
+        corpus.add(ids);
     }
+    return corpus;
+}
 
+// Finds the pairs of documents with a Jaccard index of at least "threshold" in a synthetic corpus of "count"
+// documents: MinHash signatures of "length" positions, an LSH index, and the exact Jaccard index of every
+// candidate pair. The recall is measured on a sample of documents, against the exact Jaccard index with every
+// document of their group.
+void benchmarkLsh(const Documents &base, size_t count, double threshold, int length)
+{
+    Documents corpus = syntheticCorpus(base, count);
+    std::cout << std::endl << "LSH on " << corpus.size() << " documents, " << corpus.tokenCount() << " tokens" << std::endl;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    MinHash<uint32_t> minhash(length, 1);
+    std::vector<uint32_t> signatures = minhash.signatures(corpus);
     auto stop = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
-    std::cout << "Minhashing took " << duration.count() << " ms" << std::endl;
-    return similarities;
+    std::cout << "Computing " << length << " min hashes per document took " << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count() << " ms" << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    LshParameters parameters = LshParameters::forThreshold(threshold, length);
+    LshIndex index(signatures, length, parameters);
+    stop = std::chrono::high_resolution_clock::now();
+    std::cout << "Building the index (" << parameters.bands << " bands of " << parameters.rows << " rows, S-curve at " << std::setprecision(3) << parameters.threshold()
+              << ") took " << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count() << " ms" << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    size_t candidates = 0, similar = 0;
+    index.forEachCandidate([&](uint32_t i, uint32_t o) {
+        candidates++;
+        int intersection_size = corpus.intersection(i, o);
+        int union_size = corpus.size(i) + corpus.size(o) - intersection_size;
+        if(intersection_size >= threshold * union_size) similar++;
+    });
+    stop = std::chrono::high_resolution_clock::now();
+    double pairs = corpus.size() * (corpus.size() - 1) / 2.0;
+    std::cout << candidates << " candidates (" << candidates / pairs * 100 << "% of all pairs), " << similar << " with Jaccard >= " << threshold
+              << ", took " << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count() << " ms" << std::endl;
+
+    // recall on a sample: every 997th document against the documents of its group
+    start = std::chrono::high_resolution_clock::now();
+    size_t group_size = 4 * base.size();
+    size_t truth = 0, found = 0, compared = 0;
+    for(size_t i = 0; i < corpus.size(); i += 997) {
+        size_t group_start = i / group_size * group_size;
+        for(size_t o = group_start; o < std::min(group_start + group_size, corpus.size()); o++) {
+            if(o == i) continue;
+            compared++;
+            int intersection_size = corpus.intersection(i, o);
+            int union_size = corpus.size(i) + corpus.size(o) - intersection_size;
+            if(intersection_size >= threshold * union_size) {
+                truth++;
+                if(index.isCandidate(std::min(i, o), std::max(i, o))) found++;
+            }
+        }
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    double per_pair = std::chrono::duration<double>(stop - start).count() / compared;
+    std::cout << "Recall " << found / (double)truth << " (" << found << " of " << truth << " sampled pairs, P(" << threshold << ") = " << parameters.probability(threshold)
+              << "); comparing all pairs exactly would take about " << std::setprecision(2) << pairs * per_pair << " s" << std::setprecision(6) << std::endl;
+}
+
+// Computes the MinHash signatures of a synthetic corpus with the SSE2, scalar and 64-bit Mersenne versions, and
+// compares the estimated Jaccard index of pairs of documents with the exact one.
+void benchmarkMinHash(const Documents &base, int length)
+{
+    Documents corpus = syntheticCorpus(base, 100000);
+    std::cout << std::endl << "MinHash with " << length << " hash functions on " << corpus.size() << " documents, " << corpus.tokenCount() << " tokens" << std::endl;
+
+    MinHash<uint32_t> simd(length, 7), scalar(length, 7, false);
+    MinHash<uint64_t> mersenne(length, 7);
+    std::vector<uint32_t> signatures, reference;
+    std::vector<uint64_t> signatures64;
+
+    auto time = [&](const char *name, auto compute) {
+        auto start = std::chrono::high_resolution_clock::now();
+        compute();
+        auto stop = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(stop - start).count();
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(8) << (int)(seconds * 1000) << " ms" << std::setw(10) << std::setprecision(3)
+                  << corpus.tokenCount() / seconds / 1e6 << " M tokens/s" << std::setw(10) << corpus.tokenCount() * length / seconds / 1e9 << " G hashes/s" << std::setprecision(6) << std::endl;
+    };
+#ifdef __SSE2__
+    time("uint32_t, sse2", [&]() { signatures = simd.signatures(corpus); });
+#endif
+    time("uint32_t, scalar", [&]() { reference = scalar.signatures(corpus); });
+    time("uint64_t, Mersenne 61", [&]() { signatures64 = mersenne.signatures(corpus); });
+#ifdef __SSE2__
+    std::cout << "SSE2 signatures " << (signatures == reference ? "match" : "DO NOT match") << " the scalar ones" << std::endl;
+#endif
+
+    // pairs of copies of a document (similar) and of neighbouring documents (mostly dissimilar), in the same group
+    std::vector<std::pair<int, int>> pairs;
+    for(size_t i = 0; i + base.size() < corpus.size(); i += 7) {
+        if(i / base.size() % 4 != 3) pairs.push_back(std::make_pair(i, i + base.size()));
+        pairs.push_back(std::make_pair(i, i + 1));
+    }
+
+    double error32 = 0, error64 = 0, expected = 0, maximum = 0;
+    for(const std::pair<int, int> &p : pairs) {
+        int intersection_size = corpus.intersection(p.first, p.second);
+        double exact = intersection_size / (double)(corpus.size(p.first) + corpus.size(p.second) - intersection_size);
+        double estimate32 = scalar.similarity(&reference[p.first * length], &reference[p.second * length]);
+        double estimate64 = mersenne.similarity(&signatures64[p.first * length], &signatures64[p.second * length]);
+
+        error32 += (estimate32 - exact) * (estimate32 - exact);
+        error64 += (estimate64 - exact) * (estimate64 - exact);
+        expected += exact * (1 - exact) / length;
+        maximum = std::max(maximum, std::abs(estimate32 - exact));
+    }
+    std::cout << "Estimation error on " << pairs.size() << " pairs: RMSE " << std::setprecision(3) << std::sqrt(error32 / pairs.size()) << " (uint32_t), "
+              << std::sqrt(error64 / pairs.size()) << " (uint64_t), theory " << std::sqrt(expected / pairs.size()) << ", largest " << maximum << std::setprecision(6) << std::endl;
+
+    // position-wise comparison of all pairs of the first 2000 signatures
+    int documents = std::min<size_t>(2000, corpus.size());
+    size_t total = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for(int i = 0; i < documents; i++) {
+        for(int o = i+1; o < documents; o++) {
+            const uint32_t *x = &reference[i * length], *y = &reference[o * length];
+            for(int k = 0; k < length; k++) {
+                total += (x[k] == y[k]);
+            }
+        }
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "Comparing " << documents * (documents - 1) / 2 << " pairs of signatures took " << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count() << " ms (scalar), ";
+    start = std::chrono::high_resolution_clock::now();
+    for(int i = 0; i < documents; i++) {
+        for(int o = i+1; o < documents; o++) {
+            total -= equal_positions(&reference[i * length], &reference[o * length], length);
+        }
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    std::cout << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count() << " ms (equal_positions)" << (total == 0 ? "" : ", DIFFERENT counts") << std::endl;
 }
 
 int main()
@@ -321,8 +795,41 @@ int main()
 
     // Replace strings with integeres
     // std::vector<std::set<int>> contentsId = replaceWithUniqueId(contents);
+    // StringInterner interner;
+    // std::vector<std::set<int>> contentsId = replaceWithInternedId(contents, interner);
+    // Documents documents = replaceWithHashFlat<good_hash>(contents);
+    // Documents documents = replaceWithInternedIdFlat(contents, interner);
     std::vector<std::set<int>> contentsId = replaceWithHash<good_hash>(contents);
 
+    // Compare the quadratic replaceWithUniqueId with the hash table based interners
+    compareInterning(contents);
+
+    // Compare documents as std::set with documents as flat sorted arrays on all corpora
+    for(const char *folder : {"src/quiz/", "src/isbn/", "src/synoniemen/", "src/warmste-week/", "src/yahtzee/"}) {
+        compareDocuments(folder);
+    }
+    std::cout << std::endl;
+
+    // Compare the intersection kernels on all pairs of documents
+    for(const char *folder : {"src/quiz/", "src/isbn/", "src/synoniemen/", "src/warmste-week/", "src/yahtzee/"}) {
+        benchmarkIntersection(folder);
+    }
+    std::cout << std::endl;
+
+    // Top 10 of all pairs on a thread pool, on all corpora replicated 4 times
+    // (100 copies gives about 10^10 pairs: around an hour of work for a single core)
+    benchmarkAllPairs(4, 10);
+    std::cout << std::endl;
+
+    // Only compare the candidate pairs of an LSH index, on 10^5 and 10^6 documents
+    Documents base = allCorpora(1);
+    benchmarkLsh(base, 100000, 0.75, 100);
+    benchmarkLsh(base, 1000000, 0.75, 100);
+
+    // Signatures with 32-bit and 64-bit hashes, and their estimation error
+    benchmarkMinHash(base, 100);
+    std::cout << std::endl;
+
     // Check if a certain hash function results in collisions
     // Set 2nd param true to print the detected collisions
     findCollisions<jenkins_one_at_a_time_hash>(contents, false);
@@ -330,9 +837,14 @@ int main()
     // Calculate the Jaccard similarity either on sets of strings or on sets of ints
     // std::vector<std::priority_queue6<std::pair<double, int>>> similarities = jaccard<std::string>(contents);
     // std::vector<std::priority_queue<std::pair<double, int>>> similarities = jaccard<int>(contentsId);
+    // std::vector<std::priority_queue<std::pair<double, int>>> similarities = jaccard(documents);
+    // ThreadPool pool;
+    // std::vector<std::priority_queue<std::pair<double, int>>> similarities = jaccard(documents, pool, 10);
 
     // Estimate the Jaccard similarity using minhashing
     std::vector<std::priority_queue<std::pair<double, int>>> similarities = minhashing(contentsId, 50);
+    // std::vector<std::priority_queue<std::pair<double, int>>> similarities = minhashing(documents, 50);
+    // std::vector<std::priority_queue<std::pair<double, int>>> similarities = minhashing(documents, 50, pool, 10);
 
     // Show the results
     showSummary(similarities, 0.75);
@@ -0,0 +1,252 @@
+#ifndef MINHASH_H
+#define MINHASH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "documents.h"
+
+/*
+MinHash signatures of a fixed length n.
+Position k of the signature of a document is the minimum of h_k(x) over its tokens x, so two documents have the
+same value at a position with probability equal to their Jaccard index: the fraction of equal positions is an
+estimate of it (with standard deviation sqrt(J (1 - J) / n)). Positions are compared, not sets of minima: two
+hash functions that happen to give the same minimum are still two matches.
+
+MinHash<uint32_t> uses multiply-shift hashing, h_k(x) = (a_k * x + b_k) >> 32 with 64-bit a_k and b_k.
+Everything is unsigned, so nothing overflows, and there is no modulo. With SSE2 four hash functions are
+evaluated at once per token (see signature_sse2); the result is the same as the scalar version.
+MinHash<uint64_t> uses h_k(x) = (a_k * x + b_k) mod (2^61 - 1), a Mersenne prime, so the modulo is a shift and
+an add on the 128-bit product. It is slower, but two different minima are practically never equal by accident.
+*/
+template <typename T>
+class MinHash
+{
+    static_assert(std::is_same<T, uint32_t>::value || std::is_same<T, uint64_t>::value, "signatures are uint32_t or uint64_t");
+
+public:
+    MinHash(int length, uint64_t seed, bool useSimd = true);
+
+    int length() const { return n; }
+
+    // the signature of document [begin, end) in out[0] ... out[n - 1]
+    void signature(const uint32_t *begin, const uint32_t *end, T *out) const;
+    // the signatures of all documents after each other, document i starts at i * length()
+    std::vector<T> signatures(const Documents &documents) const;
+
+    // estimated Jaccard index: the fraction of positions where the signatures are equal
+    double similarity(const T *x, const T *y) const;
+
+private:
+    static constexpr uint64_t MERSENNE_61 = (1ULL << 61) - 1;
+
+    T hash(int k, uint32_t x) const;
+    void signature_scalar(const uint32_t *begin, const uint32_t *end, T *out) const;
+#ifdef __SSE2__
+    void signature_sse2(const uint32_t *begin, const uint32_t *end, T *out) const;
+#endif
+
+    int n;
+    bool useSimd;
+    std::vector<uint64_t> a, b;
+
+    // for signature_sse2, per group of 4 hash functions k ... k + 3: the low and high halves of a_k, and b_k
+    // of the even (k, k + 2) and the odd (k + 1, k + 3) functions; n is rounded up to a multiple of 4
+    std::vector<uint32_t> a_low, a_high;
+    std::vector<uint64_t> b_even, b_odd;
+};
+
+// number of positions where x and y are equal
+size_t equal_positions(const uint32_t *x, const uint32_t *y, size_t n)
+{
+    size_t equal = 0, i = 0;
+#ifdef __SSE2__
+    // an equal lane is -1: subtracting the comparisons counts per lane, the lanes are added at the end
+    __m128i counts = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128i vx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i));
+        const __m128i vy = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + i));
+        counts = _mm_sub_epi32(counts, _mm_cmpeq_epi32(vx, vy));
+    }
+    counts = _mm_add_epi32(counts, _mm_shuffle_epi32(counts, _MM_SHUFFLE(1, 0, 3, 2)));
+    counts = _mm_add_epi32(counts, _mm_shuffle_epi32(counts, _MM_SHUFFLE(2, 3, 0, 1)));
+    equal = _mm_cvtsi128_si32(counts);
+#endif
+    for (; i < n; i++)
+    {
+        equal += (x[i] == y[i]);
+    }
+    return equal;
+}
+
+size_t equal_positions(const uint64_t *x, const uint64_t *y, size_t n)
+{
+    size_t equal = 0, i = 0;
+#ifdef __SSE2__
+    __m128i counts = _mm_setzero_si128();
+    for (; i + 2 <= n; i += 2)
+    {
+        const __m128i vx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i));
+        const __m128i vy = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + i));
+        // SSE2 only compares 32-bit lanes: a 64-bit lane is equal (-1) if both its halves are
+        const __m128i halves = _mm_cmpeq_epi32(vx, vy);
+        counts = _mm_sub_epi64(counts, _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1))));
+    }
+    equal = _mm_cvtsi128_si32(_mm_add_epi64(counts, _mm_unpackhi_epi64(counts, counts)));
+#endif
+    for (; i < n; i++)
+    {
+        equal += (x[i] == y[i]);
+    }
+    return equal;
+}
+
+template <typename T>
+MinHash<T>::MinHash(int length, uint64_t seed, bool useSimd) : n(length), useSimd(useSimd), a(length), b(length)
+{
+    std::mt19937_64 rng(seed);
+    for (int k = 0; k < n; k++)
+    {
+        if constexpr (std::is_same<T, uint32_t>::value)
+        {
+            a[k] = rng() | 1;
+            b[k] = rng();
+        }
+        else
+        {
+            a[k] = 1 + rng() % (MERSENNE_61 - 1);
+            b[k] = rng() % MERSENNE_61;
+        }
+    }
+
+    // the extra functions of the last group are evaluated, but their minima are never stored
+    const int padded = (n + 3) / 4 * 4;
+    for (int k = 0; k < padded; k++)
+    {
+        const uint64_t ak = (k < n) ? a[k] : 1, bk = (k < n) ? b[k] : 0;
+        a_low.push_back(ak);
+        a_high.push_back(ak >> 32);
+        (k % 2 == 0 ? b_even : b_odd).push_back(bk);
+    }
+}
+
+template <typename T>
+T MinHash<T>::hash(int k, uint32_t x) const
+{
+    if constexpr (std::is_same<T, uint32_t>::value)
+    {
+        return (a[k] * x + b[k]) >> 32;
+    }
+
+    // a_k * x + b_k < 2^93: fold the bits above 61 back in twice, since 2^61 = 1 (mod 2^61 - 1)
+    const unsigned __int128 product = (unsigned __int128)a[k] * x + b[k];
+    uint64_t h = (uint64_t)(product & MERSENNE_61) + (uint64_t)(product >> 61);
+    h = (h & MERSENNE_61) + (h >> 61);
+    return h >= MERSENNE_61 ? h - MERSENNE_61 : h;
+}
+
+template <typename T>
+void MinHash<T>::signature_scalar(const uint32_t *begin, const uint32_t *end, T *out) const
+{
+    std::fill(out, out + n, std::numeric_limits<T>::max());
+    for (const uint32_t *x = begin; x != end; x++)
+    {
+        for (int k = 0; k < n; k++)
+        {
+            out[k] = std::min(out[k], hash(k, *x));
+        }
+    }
+}
+
+#ifdef __SSE2__
+// SSE2 has no 64-bit multiplication, but _mm_mul_epu32 multiplies the even 32-bit lanes to 64-bit results.
+// For a = a_high 2^32 + a_low: (a x + b) >> 32 = a_high x + ((a_low x + b) >> 32) (mod 2^32), so two 32-bit
+// multiplications per hash function suffice. SSE2 has no unsigned 32-bit minimum either: the values are
+// offset by 2^31, so that the signed comparison orders them as unsigned.
+template <typename T>
+void MinHash<T>::signature_sse2(const uint32_t *begin, const uint32_t *end, T *out) const
+{
+    const int groups = a_low.size() / 4;
+    const __m128i offset = _mm_set1_epi32(0x80000000);
+    const __m128i low_halves = _mm_set_epi32(0, -1, 0, -1);
+    alignas(16) uint32_t values[4];
+
+    // one group of hash functions at a time, so that its coefficients and minima stay in registers
+    for (int g = 0; g < groups; g++)
+    {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&a_low[4 * g]));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&a_high[4 * g]));
+        const __m128i low_odd = _mm_srli_epi64(low, 32);
+        const __m128i high_odd = _mm_srli_epi64(high, 32);
+        const __m128i b_e = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&b_even[2 * g]));
+        const __m128i b_o = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&b_odd[2 * g]));
+
+        __m128i minimum = _mm_set1_epi32(0x7fffffff);
+        for (const uint32_t *x = begin; x != end; x++)
+        {
+            const __m128i vx = _mm_set1_epi32(*x);
+
+            // functions k and k + 2 in the even lanes
+            __m128i even = _mm_srli_epi64(_mm_add_epi64(_mm_mul_epu32(low, vx), b_e), 32);
+            even = _mm_add_epi32(even, _mm_mul_epu32(high, vx));
+            // functions k + 1 and k + 3, moved to the even lanes first
+            __m128i odd = _mm_srli_epi64(_mm_add_epi64(_mm_mul_epu32(low_odd, vx), b_o), 32);
+            odd = _mm_add_epi32(odd, _mm_mul_epu32(high_odd, vx));
+
+            const __m128i h = _mm_xor_si128(_mm_or_si128(_mm_and_si128(even, low_halves), _mm_slli_epi64(odd, 32)), offset);
+            const __m128i smaller = _mm_cmplt_epi32(h, minimum);
+            minimum = _mm_or_si128(_mm_and_si128(smaller, h), _mm_andnot_si128(smaller, minimum));
+        }
+
+        _mm_store_si128(reinterpret_cast<__m128i *>(values), _mm_xor_si128(minimum, offset));
+        for (int i = 0; i < 4 && 4 * g + i < n; i++)
+        {
+            out[4 * g + i] = values[i];
+        }
+    }
+}
+#endif
+
+template <typename T>
+void MinHash<T>::signature(const uint32_t *begin, const uint32_t *end, T *out) const
+{
+#ifdef __SSE2__
+    if constexpr (std::is_same<T, uint32_t>::value)
+    {
+        if (useSimd)
+        {
+            signature_sse2(begin, end, out);
+            return;
+        }
+    }
+#endif
+    signature_scalar(begin, end, out);
+}
+
+template <typename T>
+std::vector<T> MinHash<T>::signatures(const Documents &documents) const
+{
+    std::vector<T> result(documents.size() * n);
+    for (size_t i = 0; i < documents.size(); i++)
+    {
+        signature(documents.begin(i), documents.end(i), result.data() + i * n);
+    }
+    return result;
+}
+
+template <typename T>
+double MinHash<T>::similarity(const T *x, const T *y) const
+{
+    return equal_positions(x, y, n) / (double)n;
+}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A work-stealing thread pool.
+// Every worker has its own queue. A worker takes its own tasks from the back (the most recent one, which is
+// most likely still in its cache) and, when its queue is empty, steals the oldest task from the front of
+// another worker's queue. Tasks submitted by a worker go to its own queue, others are spread round-robin.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(int threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(std::function<void()> task);
+    // block until every submitted task has finished
+    void wait();
+    int size() const;
+    // index of the worker that runs the calling task (0 ... size() - 1), -1 if the caller is not one of its workers
+    int currentWorker() const;
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void work(int index);
+    bool takeOwn(int index, std::function<void()> &task);
+    bool steal(int thief, std::function<void()> &task);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable allDone;
+    // tasks that are in a queue, and tasks that are submitted but not finished yet
+    std::atomic<long long> queued{0};
+    std::atomic<long long> unfinished{0};
+    std::atomic<unsigned> nextQueue{0};
+    bool stopping = false;
+
+    // index of the worker running on this thread, -1 on other threads
+    static thread_local int workerIndex;
+    static thread_local const ThreadPool *workerPool;
+};
+
+thread_local int ThreadPool::workerIndex = -1;
+thread_local const ThreadPool *ThreadPool::workerPool = nullptr;
+
+ThreadPool::ThreadPool(int threadCount)
+{
+    if (threadCount < 1)
+    {
+        threadCount = 1;
+    }
+    for (int i = 0; i < threadCount; i++)
+    {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    wait();
+   
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+int ThreadPool::size() const
+{
+    return workers.size();
+}
+
+int ThreadPool::currentWorker() const
+{
+    return (workerPool == this) ? workerIndex : -1;
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    int index = (workerPool == this) ? workerIndex : nextQueue++ % queues.size();
+
+    unfinished++;
+   
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+   
+    {
+        // the lock makes sure a worker that is about to sleep sees the new task
+        std::lock_guard<std::mutex> lock(mutex);
+        queued++;
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this] { return unfinished == 0; });
+}
+
+bool ThreadPool::takeOwn(int index, std::function<void()> &task)
+{
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    if (queues[index]->tasks.empty())
+    {
+        return false;
+    }
+    task = std::move(queues[index]->tasks.back());
+    queues[index]->tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(int thief, std::function<void()> &task)
+{
+    const int count = queues.size();
+    for (int i = 1; i < count; i++)
+    {
+        Queue &victim = *queues[(thief + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::work(int index)
+{
+    workerIndex = index;
+    workerPool = this;
+
+    while (true)
+    {
+        std::function<void()> task;
+        if (takeOwn(index, task) || steal(index, task))
+        {
+            queued--;
+            task();
+
+            if (--unfinished == 0)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        taskAvailable.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0)
+        {
+            return;
+        }
+    }
+}
+
+#endif